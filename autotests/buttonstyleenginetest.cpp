@@ -0,0 +1,177 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License or (at your option) version 3 or any later version
+ * accepted by the membership of KDE e.V. (or its successor approved
+ * by the membership of KDE e.V.), which shall act as a proxy
+ * defined in Section 14 of version 3 of the license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "../breezebuttonstyleengine.h"
+
+#include <QImage>
+#include <QLinearGradient>
+#include <QPainter>
+#include <QRadialGradient>
+#include <QTest>
+#include <QtMath>
+
+#include <algorithm>
+#include <functional>
+
+using namespace Breeze;
+
+//* compares the cached Aqua discs with the layers painted directly, as the buttons did before caching
+class ButtonStyleEngineTest : public QObject
+{
+
+    Q_OBJECT
+
+    private Q_SLOTS:
+
+    void aquaDisc_data();
+    void aquaDisc();
+
+    private:
+
+    //* direct rendering of the Aqua layers
+    static void paintAquaLayers(QPainter *painter, const QColor &baseColor);
+
+    //* render a disc on a transparent canvas, with a 2 units wide border around the button space, moved by offset device pixels
+    static QImage render(qreal scale, qreal offset, const std::function<void(QPainter *)> &paint);
+
+};
+
+//__________________________________________________________________
+void ButtonStyleEngineTest::paintAquaLayers(QPainter *painter, const QColor &baseColor)
+{
+    const QRectF r(0, 0, 18, 18);
+
+    QRadialGradient base(r.center(), r.width()/2, QPointF(r.center().x(), r.bottom()));
+    base.setColorAt(0.0, baseColor.lighter(110));
+    base.setColorAt(0.6, baseColor);
+    base.setColorAt(1.0, baseColor.darker(110));
+    painter->setBrush(base);
+    painter->setPen(QColor(0, 0, 0, 80));
+    painter->drawEllipse(r);
+
+    const QRectF highlightRect(r.left()+4, r.top()+1, r.width()-8, r.height()/2.5);
+    QLinearGradient gloss(highlightRect.topLeft(), highlightRect.bottomLeft());
+    gloss.setColorAt(0.0, QColor(255, 255, 255, 180));
+    gloss.setColorAt(1.0, QColor(255, 255, 255, 0));
+    painter->setBrush(gloss);
+    painter->setPen(Qt::NoPen);
+    painter->drawEllipse(highlightRect);
+
+    QLinearGradient shadow(r.topLeft(), r.bottomLeft());
+    shadow.setColorAt(0.0, QColor(0, 0, 0, 0));
+    shadow.setColorAt(1.0, QColor(0, 0, 0, 80));
+    painter->setBrush(shadow);
+    painter->drawEllipse(r);
+
+    const QRectF bevelRect(r.left()+2, r.top()+r.height()/1.9, r.width()-4, r.height()/2.2);
+    QRadialGradient innerHighlight(r.center(), r.width()/2, r.center());
+    innerHighlight.setColorAt(0.0, QColor(255, 255, 255, 0));
+    innerHighlight.setColorAt(1.0, QColor(255, 255, 255, 50));
+    painter->setBrush(innerHighlight);
+    painter->drawEllipse(bevelRect);
+}
+
+//__________________________________________________________________
+QImage ButtonStyleEngineTest::render(qreal scale, qreal offset, const std::function<void(QPainter *)> &paint)
+{
+    const int size = qCeil(22*scale + offset);
+    QImage image(size, size, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+
+    QPainter painter(&image);
+    painter.setRenderHints(QPainter::Antialiasing);
+    painter.translate(offset, offset);
+    painter.scale(scale, scale);
+    painter.translate(2, 2);
+    paint(&painter);
+    painter.end();
+
+    return image;
+}
+
+//__________________________________________________________________
+void ButtonStyleEngineTest::aquaDisc_data()
+{
+    QTest::addColumn<QColor>("baseColor");
+    QTest::addColumn<bool>("emphasized");
+    QTest::addColumn<qreal>("scale");
+    QTest::addColumn<qreal>("offset");
+
+    const QList<QPair<const char *, QColor>> colors = {
+        { "close", QColor(255, 92, 87) },
+        { "maximize", QColor(39, 201, 63) },
+        { "minimize", QColor(255, 189, 46) },
+        { "inactive", QColor(180, 180, 180) }
+    };
+
+    for (const auto &color : colors)
+    {
+        // scales rounding to the same image size follow each other, so that a cache ignoring them fails
+        for (const qreal scale : { 1.0, 1.1, 1.15, 1.25, 1.5, 1.75, 2.0, 3.0 })
+        {
+            for (const qreal offset : { 0.0, 0.25, 0.5, 0.7 })
+            {
+                for (const bool emphasized : { false, true })
+                {
+                    QTest::addRow("%s-%s-%g-%g", color.first, emphasized ? "emphasized" : "normal", scale, offset)
+                        << color.second << emphasized << scale << offset;
+                }
+            }
+        }
+    }
+}
+
+//__________________________________________________________________
+void ButtonStyleEngineTest::aquaDisc()
+{
+    QFETCH(QColor, baseColor);
+    QFETCH(bool, emphasized);
+    QFETCH(qreal, scale);
+    QFETCH(qreal, offset);
+
+    const QImage expected = render(scale, offset, [&](QPainter *painter)
+    {
+        paintAquaLayers(painter, baseColor);
+        if (emphasized) paintAquaLayers(painter, baseColor);
+    });
+
+    const QImage actual = render(scale, offset, [&](QPainter *painter)
+    { ButtonStyleEngine::drawAquaDisc(painter, baseColor, emphasized); });
+
+    // the cached disc is flattened before compositing, allow for rounding of the premultiplied channels
+    const int tolerance = 3;
+    for (int y = 0; y < expected.height(); ++y)
+    {
+        for (int x = 0; x < expected.width(); ++x)
+        {
+            const QRgb e = expected.pixel(x, y);
+            const QRgb a = actual.pixel(x, y);
+            const int delta = std::max({
+                qAbs(qRed(e) - qRed(a)), qAbs(qGreen(e) - qGreen(a)),
+                qAbs(qBlue(e) - qBlue(a)), qAbs(qAlpha(e) - qAlpha(a)) });
+
+            if (delta > tolerance)
+            { QFAIL(qPrintable(QStringLiteral("pixel (%1, %2) differs: expected %3, got %4").arg(x).arg(y).arg(e, 8, 16, QLatin1Char('0')).arg(a, 8, 16, QLatin1Char('0')))); }
+        }
+    }
+}
+
+QTEST_GUILESS_MAIN(ButtonStyleEngineTest)
+
+#include "buttonstyleenginetest.moc"
@@ -19,16 +19,23 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "breezebutton.h"
+#include "breezebuttonanimator.h"
+#include "breezebuttonatlas.h"
+#include "breezebuttonglyphs.h"
+#include "breezebuttonstyleengine.h"
 
 #include <KColorUtils>
 #include <KDecoration3/DecoratedWindow>
 //#include <KIconLoader>
 
 #include <QPainter>
-#include <QPainterPath>
-#include <QVariantAnimation>
+#include <QTimer>
+#include <QEasingCurve>
 #include <QLinearGradient>
 #include <QRadialGradient>
+#include <QTransform>
+
+#include <cmath>
 
 namespace Breeze
 {
@@ -40,21 +47,10 @@ namespace Breeze
     //__________________________________________________________________
     Button::Button(DecorationButtonType type, Decoration* decoration, QObject* parent)
         : DecorationButton(type, decoration, parent)
-        , m_animation(new QVariantAnimation(this))
+        , m_decoration(decoration)
     {
 
-        // setup animation
-        // It is important start and end value are of the same type, hence 0.0 and not just 0
-        m_animation->setStartValue(0.0);
-        m_animation->setEndValue(1.0);
-        m_animation->setEasingCurve(QEasingCurve::InOutQuad);
-        connect(m_animation, &QVariantAnimation::valueChanged, this, [this](const QVariant &value) {
-            setOpacity(value.toReal());
-        });
-
         // connections
-        connect(decoration->window(), SIGNAL(iconChanged(QIcon)), this, SLOT(update()));
-        connect(decoration->settings().get(), &KDecoration3::DecorationSettings::reconfigured, this, &Button::reconfigure);
         connect(this, &KDecoration3::DecorationButton::hoveredChanged, this, &Button::updateAnimationState);
 
         reconfigure();
@@ -68,6 +64,13 @@ namespace Breeze
         setGeometry(QRectF(QPointF(0, 0), preferredSize()));
     }
 
+    //__________________________________________________________________
+    Button::~Button()
+    {
+        if (m_animationRunning) ButtonAnimator::self().stop(this);
+        if (m_appearance) ButtonAtlas::self().release(*m_appearance);
+    }
+
     //__________________________________________________________________
     Button *Button::create(DecorationButtonType type, KDecoration3::Decoration *decoration, QObject *parent)
     {
@@ -104,7 +107,7 @@ namespace Breeze
                 break;
 
                 case DecorationButtonType::Menu:
-                QObject::connect(c, &KDecoration3::DecoratedWindow::iconChanged, b, [b]() { b->update(); });
+                QObject::connect(c, &KDecoration3::DecoratedWindow::iconChanged, b, &Breeze::Button::updateIcon);
                 break;
 
                 default: break;
@@ -121,51 +124,124 @@ namespace Breeze
     //__________________________________________________________________
     void Button::paint(QPainter *painter, const QRectF &repaintRegion)
     {
-        Q_UNUSED(repaintRegion)
-
         if (!decoration()) return;
 
+        // e.g. caption only repaints
+        if (!geometry().intersects(repaintRegion)) return;
+
         painter->save();
 
         // menu button
         if (type() == DecorationButtonType::Menu)
         {
-            const QRectF iconRect = geometry().marginsRemoved(m_padding);
-            const auto w = decoration()->window();
-            /*if (auto deco = qobject_cast<Decoration *>(decoration())) {
-                const QPalette activePalette = KIconLoader::global()->customPalette();
-                QPalette palette = w->palette();
-                palette.setColor(QPalette::WindowText, deco->fontColor());
-                KIconLoader::global()->setCustomPalette(palette);
-                w->icon().paint(painter, iconRect.toRect());
-                if (activePalette == QPalette()) {
-                    KIconLoader::global()->resetPalette();
-                } else {
-                    KIconLoader::global()->setCustomPalette(palette);
-                }
-            } else {*/
-                w->icon().paint(painter, iconRect.toRect());
-            //}
+            const QRect iconRect = geometry().marginsRemoved(m_padding).toRect();
+            const QIcon icon = decoration()->window()->icon();
+            const qreal devicePixelRatio = painter->device()->devicePixelRatioF();
+
+            // the icon is only rendered again when it, the button size or the scale changes
+            if (m_iconPixmap.isNull()
+                || m_iconCacheKey != icon.cacheKey()
+                || m_iconSize != iconRect.size()
+                || m_iconDevicePixelRatio != devicePixelRatio)
+            {
+                m_iconPixmap = icon.pixmap(iconRect.size(), devicePixelRatio);
+                m_iconCacheKey = icon.cacheKey();
+                m_iconSize = iconRect.size();
+                m_iconDevicePixelRatio = devicePixelRatio;
+            }
+
+            // centered, like QIcon::paint does
+            QRect pixmapRect(QPoint(0, 0), m_iconPixmap.deviceIndependentSize().toSize());
+            pixmapRect.moveCenter(iconRect.center());
+            painter->drawPixmap(pixmapRect, m_iconPixmap);
         }
-        else {
-
-            auto d = qobject_cast<Decoration*>( decoration() );
-
-            if ( d && d->internalSettings()->buttonStyle() == 0 )
-                drawIcon(painter);
-            else if ( d && d->internalSettings()->buttonStyle() == 1 )
-                drawIconAqua( painter );
-            else if ( d && d->internalSettings()->buttonStyle() == 2 )
-                drawIconMacSierra( painter );
-            else if ( d && d->internalSettings()->buttonStyle() == 3 )
-                drawIconPlasma( painter );
+        else if (auto d = m_decoration.data())
+        {
+
+            const int frames = m_animationFrames;
+            if (m_animationRunning && frames < 2)
+            {
+                // animation steps are rendered directly
+                drawButton(painter, m_opacity);
+            }
+            else
+            {
+                // static states and quantized animation frames are rendered once and shared by all windows
+                const auto w = d->window();
+                const QRectF rect = geometry().marginsRemoved(m_padding);
+
+                ButtonAtlas::Key key;
+                key.style = m_buttonStyle;
+                key.type = static_cast<int>(type());
+                if (isChecked()) key.state |= ButtonAtlas::Checked;
+                if (isHovered()) key.state |= ButtonAtlas::Hovered;
+                if (isPressed()) key.state |= ButtonAtlas::Pressed;
+                if (w->isActive()) key.state |= ButtonAtlas::Active;
+                if (m_macOSButtons) key.state |= ButtonAtlas::MacOSButtons;
+                key.progress = m_opacity;
+                key.size = rect.size();
+                key.devicePixelRatio = painter->device()->devicePixelRatioF();
+
+                // the image is blitted to whole device pixels, and holds the button at its sub pixel position
+                const QTransform &transform(painter->deviceTransform());
+                const QPointF origin(transform.map(rect.topLeft()));
+                key.phase = QPointF(origin.x() - std::floor(origin.x()), origin.y() - std::floor(origin.y()));
+                key.titleBarColor = d->buttonColors().titleBar.rgba();
+                key.fontColor = d->buttonColors().font.rgba();
+                key.warningColor = d->buttonColors().closePressed.rgba();
+
+                // renders the button at given animation progress
+                const auto renderer = [this, &rect](qreal progress) -> ButtonAtlas::Renderer {
+                    return [this, &rect, progress](QPainter *p) {
+                        p->translate(-rect.topLeft());
+                        drawButton(p, progress);
+                    };
+                };
+
+                QImage image;
+                if (m_animationRunning)
+                {
+                    // all frames of this appearance are rendered on first hover
+                    key.state |= ButtonAtlas::Animated;
+                    key.progress = qRound(m_opacity*(frames - 1))/qreal(frames - 1);
+                    if (!ButtonAtlas::self().contains(key))
+                    {
+                        auto frameKey = key;
+                        for (int frame = 0; frame < frames; ++frame)
+                        {
+                            frameKey.progress = qreal(frame)/(frames - 1);
+                            ButtonAtlas::self().image(frameKey, renderer(frameKey.progress));
+                        }
+                    }
+
+                    image = ButtonAtlas::self().image(key, renderer(key.progress));
+                }
+                else if (m_appearance && *m_appearance == key) image = ButtonAtlas::self().image(key, renderer(key.progress));
+                else
+                {
+                    // the shown appearance is kept alive in the shared cache
+                    if (m_appearance) ButtonAtlas::self().release(*m_appearance);
+                    image = ButtonAtlas::self().acquire(key, renderer(key.progress));
+                    m_appearance = key;
+                }
+
+                painter->drawImage(QRectF(rect.topLeft() - key.phase/transform.m11(), image.deviceIndependentSize()), image);
             }
+
+        }
+
         painter->restore();
 
     }
 
     //__________________________________________________________________
-    void Button::drawIcon(QPainter *painter) const
+    void Button::drawButton(QPainter *painter, qreal progress) const
+    {
+        if (m_renderer) (this->*m_renderer)(painter, progress);
+    }
+
+    //__________________________________________________________________
+    void Button::drawIcon(QPainter *painter, qreal progress) const
     {
 
         painter->setRenderHints(QPainter::Antialiasing);
@@ -183,389 +259,43 @@ namespace Breeze
         painter->translate(1, 1);
 
         // render background
-        const QColor backgroundColor(this->backgroundColor());
+        const QColor backgroundColor(this->backgroundColor(progress));
 
-        auto d = qobject_cast<Decoration*>(decoration());
+        auto d = m_decoration.data();
         bool isInactive(d && !d->window()->isActive()
                         && !isHovered() && !isPressed()
-                        && m_animation->state() != QAbstractAnimation::Running);
-        QColor inactiveCol(Qt::gray);
-        if (isInactive)
-        {
-            int gray = qGray(d->titleBarColor().rgb());
-            if (gray <= 200) {
-                gray += 55;
-                gray = qMax(gray, 115);
-            }
-            else gray -= 45;
-            inactiveCol = QColor(gray, gray, gray);
-        }
+                        && !m_animationRunning);
+        const QColor inactiveCol(isInactive ? d->buttonColors().inactive : QColor(Qt::gray));
 
-        // render mark
-        const QColor foregroundColor(this->foregroundColor(inactiveCol));
+        // render disc
+        const QColor foregroundColor(this->foregroundColor(progress));
         if (foregroundColor.isValid())
-        {
-
-            // setup painter
-            QPen pen(foregroundColor);
-            pen.setCapStyle(Qt::RoundCap);
-            pen.setJoinStyle(Qt::MiterJoin);
-            pen.setWidthF(PenWidth::Symbol*qMax((qreal)1.0, 20/width));
-
-            switch (type())
-            {
-
-                case DecorationButtonType::Close:
-                {
-                        QLinearGradient grad(QPointF(9, 2), QPointF(9, 16));
-                        if (d && qGray(d->titleBarColor().rgb()) > 100)
-                        {
-                            grad.setColorAt(0, isInactive ? inactiveCol
-                                                          : QColor(255, 92, 87));
-                            grad.setColorAt(1, isInactive ? inactiveCol
-                                                          : QColor(233, 84, 79));
-                        }
-                        else
-                        {
-                            grad.setColorAt(0, isInactive ? inactiveCol
-                                                          : QColor(250, 100, 102));
-                            grad.setColorAt(1, isInactive ? inactiveCol
-                                                          : QColor(230, 92, 94));
-                        }
-                        painter->setBrush(QBrush(grad));
-                        painter->setPen(Qt::NoPen);
-                        painter->drawEllipse(QRectF(1, 1, 16, 16));
-                        if (backgroundColor.isValid())
-                        {
-                            painter->setPen(Qt::NoPen);
-                            painter->setBrush(backgroundColor);
-                            qreal r = static_cast<qreal>(7)
-                                      + (isPressed() ? 0.0
-                                         : static_cast<qreal>(2) * m_animation->currentValue().toReal());
-                            QPointF c(static_cast<qreal>(9), static_cast<qreal>(9));
-                            painter->drawEllipse(c, r, r);
-                        }
-
-                    break;
-                }
-
-                case DecorationButtonType::Maximize:
-                {
-                        QLinearGradient grad(QPointF(9, 2), QPointF(9, 16));
-                        if (d && qGray(d->titleBarColor().rgb()) > 100)
-                        {
-                            grad.setColorAt(0, isChecked() ? isInactive ? inactiveCol
-                                                                        : QColor(67, 198, 176)
-                                                           : isInactive ? inactiveCol
-                                                                        : QColor(40, 211, 63));
-                            grad.setColorAt(1, isChecked() ? isInactive ? inactiveCol
-                                                                        : QColor(60, 178, 159)
-                                                           : isInactive ? inactiveCol
-                                                                        : QColor(36, 191, 57));
-                        }
-                        else
-                        {
-                            grad.setColorAt(0, isChecked() ? isInactive ? inactiveCol
-                                                                        : QColor(67, 198, 176)
-                                                           : isInactive ? inactiveCol
-                                                                        : QColor(124, 198, 67));
-                            grad.setColorAt(1, isChecked() ? isInactive ? inactiveCol
-                                                                        : QColor(60, 178, 159)
-                                                           : isInactive ? inactiveCol
-                                                                        : QColor(111, 178, 60));
-                        }
-                        painter->setBrush(QBrush(grad));
-                        painter->setPen(Qt::NoPen);
-                        painter->drawEllipse(QRectF(1, 1, 16, 16));
-                        if (backgroundColor.isValid())
-                        {
-                            painter->setPen(Qt::NoPen);
-                            painter->setBrush(backgroundColor);
-                            qreal r = static_cast<qreal>(7)
-                                      + (isPressed() ? 0.0
-                                         : static_cast<qreal>(2) * m_animation->currentValue().toReal());
-                            QPointF c(static_cast<qreal>(9), static_cast<qreal>(9));
-                            painter->drawEllipse(c, r, r);
-                        }
-                    break;
-                }
-
-                case DecorationButtonType::Minimize:
-                {
-                        QLinearGradient grad(QPointF(9, 2), QPointF(9, 16));
-                        if (d && qGray(d->titleBarColor().rgb()) > 100)
-                        { // yellow isn't good with light backgrounds
-                            grad.setColorAt(0, isInactive ? inactiveCol
-                                                          : QColor(243, 176, 43));
-                            grad.setColorAt(1, isInactive ? inactiveCol
-                                                          : QColor(223, 162, 39));
-                        }
-                        else
-                        {
-                            grad.setColorAt(0, isInactive ? inactiveCol
-                                                          : QColor(237, 198, 81));
-                            grad.setColorAt(1, isInactive ? inactiveCol
-                                                          : QColor(217, 181, 74));
-                        }
-                        painter->setBrush(QBrush(grad));
-                        painter->setPen(Qt::NoPen);
-                        painter->drawEllipse(QRectF(1, 1, 16, 16));
-                        if (backgroundColor.isValid())
-                        {
-                            painter->setPen(Qt::NoPen);
-                            painter->setBrush(backgroundColor);
-                            qreal r = static_cast<qreal>(7)
-                                      + (isPressed() ? 0.0
-                                         : static_cast<qreal>(2) * m_animation->currentValue().toReal());
-                            QPointF c(static_cast<qreal>(9), static_cast<qreal>(9));
-                            painter->drawEllipse(c, r, r);
-                        }
-                    break;
-                }
-
-                case DecorationButtonType::OnAllDesktops:
-                {
-                    bool macOSBtn(!d || d->internalSettings()->macOSButtons());
-                    if (macOSBtn && !isPressed()) {
-                        QLinearGradient grad(QPointF(9, 2), QPointF(9, 16));
-                        if (d && qGray(d->titleBarColor().rgb()) > 100)
-                        { // yellow isn't good with light backgrounds
-                            grad.setColorAt(0, isInactive ? inactiveCol
-                                                          : QColor(103, 149, 210));
-                            grad.setColorAt(1, isInactive ? inactiveCol
-                                                          : QColor(93, 135, 190));
-                        }
-                        else
-                        {
-                            grad.setColorAt(0, isInactive ? inactiveCol
-                                                          : QColor(135, 166, 220));
-                            grad.setColorAt(1, isInactive ? inactiveCol
-                                                          : QColor(122, 151, 200));
-                        }
-                        painter->setBrush(QBrush(grad));
-                        painter->setPen(Qt::NoPen);
-                        if (isChecked())
-                            painter->drawEllipse(QRectF(0, 0, 18, 18));
-                        else {
-                            painter->drawEllipse(QRectF(1, 1, 16, 16));
-                            if (backgroundColor.isValid())
-                            {
-                                painter->setPen(Qt::NoPen);
-                                painter->setBrush(backgroundColor);
-                                qreal r = static_cast<qreal>(7)
-                                          + static_cast<qreal>(2) * m_animation->currentValue().toReal();
-                                QPointF c(static_cast<qreal>(9), static_cast<qreal>(9));
-                                painter->drawEllipse(c, r, r);
-                            }
-                        }
-                    }
-
-                    break;
-                }
-
-                case DecorationButtonType::Shade:
-                {
-                    bool macOSBtn(!d || d->internalSettings()->macOSButtons());
-                    if (macOSBtn && !isPressed()) {
-                        QLinearGradient grad(QPointF(9, 2), QPointF(9, 16));
-                        if (d && qGray(d->titleBarColor().rgb()) > 100)
-                        { // yellow isn't good with light backgrounds
-                            grad.setColorAt(0, isInactive ? inactiveCol
-                                                          : QColor(103, 149, 210));
-                            grad.setColorAt(1, isInactive ? inactiveCol
-                                                          : QColor(93, 135, 190));
-                        }
-                        else
-                        {
-                            grad.setColorAt(0, isInactive ? inactiveCol
-                                                          : QColor(135, 166, 220));
-                            grad.setColorAt(1, isInactive ? inactiveCol
-                                                          : QColor(122, 151, 200));
-                        }
-                        painter->setBrush(QBrush(grad));
-                        painter->setPen(Qt::NoPen);
-                        if (isChecked())
-                            painter->drawEllipse(QRectF(0, 0, 18, 18));
-                        else {
-                            painter->drawEllipse(QRectF(1, 1, 16, 16));
-                            if (backgroundColor.isValid())
-                            {
-                                painter->setPen(Qt::NoPen);
-                                painter->setBrush(backgroundColor);
-                                qreal r = static_cast<qreal>(7)
-                                          + static_cast<qreal>(2) * m_animation->currentValue().toReal();
-                                QPointF c(static_cast<qreal>(9), static_cast<qreal>(9));
-                                painter->drawEllipse(c, r, r);
-                            }
-                        }
-                    }
-
-                    break;
-
-                }
-
-                case DecorationButtonType::KeepBelow:
-                {
-                    bool macOSBtn(!d || d->internalSettings()->macOSButtons() || isChecked());
-                    if (macOSBtn && !isPressed()) {
-                        QLinearGradient grad(QPointF(9, 2), QPointF(9, 16));
-                        if (d && qGray(d->titleBarColor().rgb()) > 100)
-                        { // yellow isn't good with light backgrounds
-                            grad.setColorAt(0, isInactive ? inactiveCol
-                                                          : QColor(103, 149, 210));
-                            grad.setColorAt(1, isInactive ? inactiveCol
-                                                          : QColor(93, 135, 190));
-                        }
-                        else
-                        {
-                            grad.setColorAt(0, isInactive ? inactiveCol
-                                                          : QColor(135, 166, 220));
-                            grad.setColorAt(1, isInactive ? inactiveCol
-                                                          : QColor(122, 151, 200));
-                        }
-                        painter->setBrush(QBrush(grad));
-                        painter->setPen(Qt::NoPen);
-                        if (isChecked())
-                            painter->drawEllipse(QRectF(0, 0, 18, 18));
-                        else {
-                            painter->drawEllipse(QRectF(1, 1, 16, 16));
-                            if (backgroundColor.isValid())
-                            {
-                                painter->setPen(Qt::NoPen);
-                                painter->setBrush(backgroundColor);
-                                qreal r = static_cast<qreal>(7)
-                                          + static_cast<qreal>(2) * m_animation->currentValue().toReal();
-                                QPointF c(static_cast<qreal>(9), static_cast<qreal>(9));
-                                painter->drawEllipse(c, r, r);
-                            }
-                        }
-                    }
-                    break;
-
-                }
-
-                case DecorationButtonType::KeepAbove:
-                {
-                    bool macOSBtn(!d || d->internalSettings()->macOSButtons());
-                    if (macOSBtn && !isPressed()) {
-                        QLinearGradient grad(QPointF(9, 2), QPointF(9, 16));
-                        if (d && qGray(d->titleBarColor().rgb()) > 100)
-                        { // yellow isn't good with light backgrounds
-                            grad.setColorAt(0, isInactive ? inactiveCol
-                                                          : QColor(103, 149, 210));
-                            grad.setColorAt(1, isInactive ? inactiveCol
-                                                          : QColor(93, 135, 190));
-                        }
-                        else
-                        {
-                            grad.setColorAt(0, isInactive ? inactiveCol
-                                                          : QColor(135, 166, 220));
-                            grad.setColorAt(1, isInactive ? inactiveCol
-                                                          : QColor(122, 151, 200));
-                        }
-                        painter->setBrush(QBrush(grad));
-                        painter->setPen(Qt::NoPen);
-                        if (isChecked())
-                            painter->drawEllipse(QRectF(0, 0, 18, 18));
-                        else {
-                            painter->drawEllipse(QRectF(1, 1, 16, 16));
-                            if (backgroundColor.isValid())
-                            {
-                                painter->setPen(Qt::NoPen);
-                                painter->setBrush(backgroundColor);
-                                qreal r = static_cast<qreal>(7)
-                                          + static_cast<qreal>(2) * m_animation->currentValue().toReal();
-                                QPointF c(static_cast<qreal>(9), static_cast<qreal>(9));
-                                painter->drawEllipse(c, r, r);
-                            }
-                        }
-                    }
-
-                    break;
-                }
-
-
-                case DecorationButtonType::ApplicationMenu:
-                {
-                    bool macOSBtn(!d || d->internalSettings()->macOSButtons());
-                    if (macOSBtn && !isPressed()) {
-                        QLinearGradient grad(QPointF(9, 2), QPointF(9, 16));
-                        if (d && qGray(d->titleBarColor().rgb()) > 100)
-                        { // yellow isn't good with light backgrounds
-                            grad.setColorAt(0, isInactive ? inactiveCol
-                                                          : QColor(230, 129, 67));
-                            grad.setColorAt(1, isInactive ? inactiveCol
-                                                          : QColor(210, 118, 61));
-                        }
-                        else
-                        {
-                            grad.setColorAt(0, isInactive ? inactiveCol
-                                                          : QColor(250, 145, 100));
-                            grad.setColorAt(1, isInactive ? inactiveCol
-                                                          : QColor(230, 131, 92));
-                        }
-                        painter->setBrush(QBrush(grad));
-                        painter->setPen(Qt::NoPen);
-                        painter->drawEllipse(QRectF(1, 1, 16, 16));
-                        if (backgroundColor.isValid())
-                        {
-                            painter->setPen(Qt::NoPen);
-                            painter->setBrush(backgroundColor);
-                            qreal r = static_cast<qreal>(7)
-                                      + static_cast<qreal>(2) * m_animation->currentValue().toReal();
-                            QPointF c(static_cast<qreal>(9), static_cast<qreal>(9));
-                            painter->drawEllipse(c, r, r);
-                        }
-                    }
-
-                    break;
-                }
-
-                case DecorationButtonType::ContextHelp:
-                {
-                    bool macOSBtn(!d || d->internalSettings()->macOSButtons());
-                    if (macOSBtn && !isPressed()) {
-                        QLinearGradient grad(QPointF(9, 2), QPointF(9, 16));
-                        if (d && qGray(d->titleBarColor().rgb()) > 100)
-                        { // yellow isn't good with light backgrounds
-                            grad.setColorAt(0, isInactive ? inactiveCol
-                                                          : QColor(103, 149, 210));
-                            grad.setColorAt(1, isInactive ? inactiveCol
-                                                          : QColor(93, 135, 190));
-                        }
-                        else
-                        {
-                            grad.setColorAt(0, isInactive ? inactiveCol
-                                                          : QColor(135, 166, 220));
-                            grad.setColorAt(1, isInactive ? inactiveCol
-                                                          : QColor(122, 151, 200));
-                        }
-                        painter->setBrush(QBrush(grad));
-                        painter->setPen(Qt::NoPen);
-                        painter->drawEllipse(QRectF(1, 1, 16, 16));
-                        if (backgroundColor.isValid())
-                        {
-                            painter->setPen(Qt::NoPen);
-                            painter->setBrush(backgroundColor);
-                            qreal r = static_cast<qreal>(7)
-                                      + static_cast<qreal>(2) * m_animation->currentValue().toReal();
-                            QPointF c(static_cast<qreal>(9), static_cast<qreal>(9));
-                            painter->drawEllipse(c, r, r);
-                        }
-                    }
-
-                    break;
-                }
-
-                default: break;
+        { drawDisc(painter, 0, backgroundColor, isInactive, inactiveCol, progress); }
 
-            }
-
-        }
+    }
 
+    //__________________________________________________________________
+    void Button::drawDisc(QPainter *painter, int style, const QColor &backgroundColor, bool isInactive, const QColor &inactiveCol, qreal progress) const
+    {
+        const auto layer = ButtonStyleEngine::discLayer(style, type());
+        if (!layer) return;
+
+        auto d = m_decoration.data();
+
+        ButtonStyleEngine::DiscState state;
+        state.titleBarGray = d ? d->buttonColors().titleBarGray : 0;
+        state.macOS = !d || m_macOSButtons;
+        state.checked = isChecked();
+        state.pressed = isPressed();
+        state.inactive = isInactive;
+        state.inactiveColor = inactiveCol;
+        state.backgroundColor = backgroundColor;
+        state.progress = progress;
+        ButtonStyleEngine::drawDiscLayer(painter, *layer, state);
     }
+
     //__________________________________________________________________
-    void Button::drawIconPlasma(QPainter *painter) const
+    void Button::drawIconPlasma(QPainter *painter, qreal progress) const
     {
 
         painter->setRenderHints(QPainter::Antialiasing);
@@ -583,29 +313,19 @@ namespace Breeze
         painter->translate(1, 1);
 
         // render background
-        const QColor backgroundColor(this->backgroundColor());
+        const QColor backgroundColor(this->backgroundColor(progress));
 
-        auto d = qobject_cast<Decoration*>(decoration());
+        auto d = m_decoration.data();
         bool isInactive(d && !d->window()->isActive()
         && !isHovered() && !isPressed()
-        && m_animation->state() != QAbstractAnimation::Running);
-        QColor inactiveCol(Qt::gray);
-        if (isInactive)
-        {
-            int gray = qGray(d->titleBarColor().rgb());
-            if (gray <= 200) {
-                gray += 55;
-                gray = qMax(gray, 115);
-            }
-            else gray -= 45;
-            inactiveCol = QColor(gray, gray, gray);
-        }
+        && !m_animationRunning);
+        const QColor inactiveCol(isInactive ? d->buttonColors().inactive : QColor(Qt::gray));
 
         QColor symbolColor;
         symbolColor = QColor(34, 45, 50);
 
         // render mark
-        const QColor foregroundColor(this->foregroundColor(inactiveCol));
+        const QColor foregroundColor(this->foregroundColor(progress));
         if (foregroundColor.isValid())
         {
 
@@ -629,14 +349,12 @@ namespace Breeze
                         painter->setPen(pen);
                         painter->setBrush(symbolColor);
 
-                        painter->drawLine(QPointF(5, 5), QPointF(13, 13));
-                        painter->drawLine(QPointF(5, 13), QPointF(13, 5));
+                        ButtonGlyphs::stroke(painter, ButtonGlyphs::Close, pen);
                         if (isHovered()) {
                             painter->setPen(pen);
                             painter->setBrush(symbolColor);
 
-                            painter->drawLine( QPointF( 6, 6 ), QPointF( 12, 12 ) );
-                            painter->drawLine( QPointF( 6, 12 ), QPointF( 12, 6 ) );
+                            ButtonGlyphs::stroke(painter, ButtonGlyphs::CloseSmall, pen);
                         }
 
                     break;
@@ -654,16 +372,12 @@ namespace Breeze
                         if (isHovered())
                             pen.setWidthF(1.2*qMax((qreal)1.0, 20/width));
                         painter->setPen(pen);
-                        painter->setBrush(symbolColor);
 
-                        painter->drawPolyline(QPolygonF()
-                        << QPointF(5, 8) << QPointF(5, 13) << QPointF(10, 13));
+                        // the restore square is filled
                         if (isChecked())
-                            painter->drawRect(QRectF(8.0, 5.0, 5.0, 5.0));
-                        else {
-                            painter->drawPolyline(QPolygonF()
-                            << QPointF(8, 5) << QPointF(13, 5) << QPointF(13, 10));
-                        }
+                            painter->fillRect(QRectF(8.0, 5.0, 5.0, 5.0), symbolColor);
+
+                        ButtonGlyphs::stroke(painter, isChecked() ? ButtonGlyphs::Restore : ButtonGlyphs::Maximize, pen);
 
                         if (isHovered())
                             pen.setWidthF(PenWidth::Symbol*qMax((qreal)1.0, 20/width));
@@ -685,7 +399,7 @@ namespace Breeze
                         painter->setPen(pen);
                         painter->setBrush(symbolColor);
 
-                        painter->drawLine(QPointF(4, 9), QPointF(14, 9));
+                        ButtonGlyphs::stroke(painter, ButtonGlyphs::Minimize, pen);
 
                         if (isHovered())
                             pen.setWidthF(PenWidth::Symbol*qMax((qreal)1.0, 20/width));
@@ -695,7 +409,7 @@ namespace Breeze
 
                 case DecorationButtonType::OnAllDesktops:
                 {
-                    bool macOSBtn(!d || d->internalSettings()->macOSButtons());
+                    bool macOSBtn(!d || m_macOSButtons);
                     if (!macOSBtn || isPressed() || isHovered() || isChecked()) {
                         painter->setPen(Qt::NoPen);
                         if ((!macOSBtn  || isPressed()) && backgroundColor.isValid())
@@ -714,7 +428,7 @@ namespace Breeze
                                 painter->drawEllipse(QRectF(3, 3, 12, 12));
 
                                 // center dot
-                                QColor backgroundColor(this->backgroundColor());
+                                QColor backgroundColor(this->backgroundColor(progress));
                                 if (!backgroundColor.isValid() && d) backgroundColor = d->titleBarColor();
 
                                 if (backgroundColor.isValid())
@@ -725,15 +439,10 @@ namespace Breeze
 
                             }
                             else {
-                                painter->drawPolygon(QPolygonF()
-                                << QPointF(6.5, 8.5)
-                                << QPointF(12, 3)
-                                << QPointF(15, 6)
-                                << QPointF(9.5, 11.5));
+                                ButtonGlyphs::fill(painter, ButtonGlyphs::PinHead, foregroundColor);
 
                                 painter->setPen(pen);
-                                painter->drawLine(QPointF(5.5, 7.5), QPointF(10.5, 12.5));
-                                painter->drawLine(QPointF(12, 6), QPointF(4.5, 13.5));
+                                ButtonGlyphs::stroke(painter, ButtonGlyphs::PinNeedle, pen);
                             }
                         }
                     }
@@ -742,7 +451,7 @@ namespace Breeze
 
                 case DecorationButtonType::Shade:
                 {
-                    bool macOSBtn(!d || d->internalSettings()->macOSButtons());
+                    bool macOSBtn(!d || m_macOSButtons);
                     if (!macOSBtn || isPressed() || isHovered() || isChecked()) {
                         if ((!macOSBtn  || isPressed()) && backgroundColor.isValid())
                         {
@@ -753,20 +462,7 @@ namespace Breeze
                         painter->setPen(pen);
                         painter->setBrush(Qt::NoBrush);
 
-                        painter->drawLine(5, 6, 13, 6);
-                        if (isChecked()) {
-                            painter->drawPolyline(QPolygonF()
-                            << QPointF(5, 9)
-                            << QPointF(9, 13)
-                            << QPointF(13, 9));
-
-                        }
-                        else {
-                            painter->drawPolyline(QPolygonF()
-                            << QPointF(5, 13)
-                            << QPointF(9, 9)
-                            << QPointF(13, 13));
-                        }
+                        ButtonGlyphs::stroke(painter, isChecked() ? ButtonGlyphs::Unshade : ButtonGlyphs::Shade, pen);
                     }
 
                     break;
@@ -775,7 +471,7 @@ namespace Breeze
 
                 case DecorationButtonType::KeepBelow:
                 {
-                    bool macOSBtn(!d || d->internalSettings()->macOSButtons() || isChecked());
+                    bool macOSBtn(!d || m_macOSButtons || isChecked());
                     if (!macOSBtn || isPressed() || isHovered() || isChecked()) {
                         if ((!macOSBtn  || isPressed()) && backgroundColor.isValid())
                         {
@@ -786,28 +482,7 @@ namespace Breeze
                         painter->setPen(pen);
                         painter->setBrush(Qt::NoBrush);
 
-                        if (macOSBtn) {
-                            painter->drawPolyline(QPolygonF()
-                            << QPointF(6, 6)
-                            << QPointF(9, 9)
-                            << QPointF(12, 6));
-
-                            painter->drawPolyline(QPolygonF()
-                            << QPointF(6, 10)
-                            << QPointF(9, 13)
-                            << QPointF(12, 10));
-                        }
-                        else {
-                            painter->drawPolyline(QPolygonF()
-                            << QPointF(5, 5)
-                            << QPointF(9, 9)
-                            << QPointF(13, 5));
-
-                            painter->drawPolyline(QPolygonF()
-                            << QPointF(5, 9)
-                            << QPointF(9, 13)
-                            << QPointF(13, 9));
-                        }
+                        ButtonGlyphs::stroke(painter, macOSBtn ? ButtonGlyphs::KeepBelowSmall : ButtonGlyphs::KeepBelow, pen);
                     }
                     break;
 
@@ -815,7 +490,7 @@ namespace Breeze
 
                 case DecorationButtonType::KeepAbove:
                 {
-                    bool macOSBtn(!d || d->internalSettings()->macOSButtons());
+                    bool macOSBtn(!d || m_macOSButtons);
                     if (!macOSBtn || isPressed() || isHovered() || isChecked()) {
                         if ((!macOSBtn  || isPressed()) && backgroundColor.isValid())
                         {
@@ -826,28 +501,7 @@ namespace Breeze
                         painter->setPen(pen);
                         painter->setBrush(Qt::NoBrush);
 
-                        if (macOSBtn) {
-                            painter->drawPolyline(QPolygonF()
-                            << QPointF(6, 8)
-                            << QPointF(9, 5)
-                            << QPointF(12, 8));
-
-                            painter->drawPolyline(QPolygonF()
-                            << QPointF(6, 12)
-                            << QPointF(9, 9)
-                            << QPointF(12, 12));
-                        }
-                        else {
-                            painter->drawPolyline(QPolygonF()
-                            << QPointF(5, 9)
-                            << QPointF(9, 5)
-                            << QPointF(13, 9));
-
-                            painter->drawPolyline(QPolygonF()
-                            << QPointF(5, 13)
-                            << QPointF(9, 9)
-                            << QPointF(13, 13));
-                        }
+                        ButtonGlyphs::stroke(painter, macOSBtn ? ButtonGlyphs::KeepAboveSmall : ButtonGlyphs::KeepAbove, pen);
                     }
                     break;
                 }
@@ -855,7 +509,7 @@ namespace Breeze
 
                 case DecorationButtonType::ApplicationMenu:
                 {
-                    bool macOSBtn(!d || d->internalSettings()->macOSButtons());
+                    bool macOSBtn(!d || m_macOSButtons);
                     if (!macOSBtn || isPressed() || isHovered()) {
                         if ((!macOSBtn  || isPressed()) && backgroundColor.isValid())
                         {
@@ -866,23 +520,14 @@ namespace Breeze
                         painter->setPen(pen);
                         painter->setBrush(Qt::NoBrush);
 
-                        if (macOSBtn) {
-                            painter->drawLine(QPointF(4.5, 6), QPointF(13.5, 6));
-                            painter->drawLine(QPointF(4.5, 9), QPointF(13.5, 9));
-                            painter->drawLine(QPointF(4.5, 12), QPointF(13.5, 12));
-                        }
-                        else {
-                            painter->drawLine(QPointF(3.5, 5), QPointF(14.5, 5));
-                            painter->drawLine(QPointF(3.5, 9), QPointF(14.5, 9));
-                            painter->drawLine(QPointF(3.5, 13), QPointF(14.5, 13));
-                        }
+                        ButtonGlyphs::stroke(painter, macOSBtn ? ButtonGlyphs::ApplicationMenuSmall : ButtonGlyphs::ApplicationMenu, pen);
                     }
                     break;
                 }
 
                 case DecorationButtonType::ContextHelp:
                 {
-                    bool macOSBtn(!d || d->internalSettings()->macOSButtons());
+                    bool macOSBtn(!d || m_macOSButtons);
                     if (!macOSBtn || isPressed() || isHovered()) {
                         if ((!macOSBtn  || isPressed()) && backgroundColor.isValid())
                         {
@@ -893,13 +538,7 @@ namespace Breeze
                         painter->setPen(pen);
                         painter->setBrush(Qt::NoBrush);
 
-                        QPainterPath path;
-                        path.moveTo(5, 6);
-                        path.arcTo(QRectF(5, 3.5, 8, 5), 180, -180);
-                        path.cubicTo(QPointF(12.5, 9.5), QPointF(9, 7.5), QPointF(9, 11.5));
-                        painter->drawPath(path);
-
-                        painter->drawPoint(9, 15);
+                        ButtonGlyphs::stroke(painter, ButtonGlyphs::ContextHelp, pen);
                     }
 
                     break;
@@ -914,7 +553,7 @@ namespace Breeze
     }
 
     //__________________________________________________________________
-    void Button::drawIconAqua( QPainter *painter ) const
+    void Button::drawIconMacOS(QPainter *painter, qreal progress) const
     {
         painter->setRenderHints(QPainter::Antialiasing);
 
@@ -930,1866 +569,259 @@ namespace Breeze
         painter->scale(width/20, width/20);
         painter->translate(1, 1);
 
-        // render background
-        const QColor backgroundColor(this->backgroundColor());
+        const QColor foregroundColor(this->foregroundColor(progress));
+        if (!foregroundColor.isValid()) return;
+
+        // render disc
+        const QColor backgroundColor(this->backgroundColor(progress));
 
-        auto d = qobject_cast<Decoration*>(decoration());
+        auto d = m_decoration.data();
         bool isInactive(d && !d->window()->isActive()
         && !isHovered() && !isPressed()
-        && m_animation->state() != QAbstractAnimation::Running);
-        QColor inactiveCol(Qt::gray);
-        if (isInactive)
+        && !m_animationRunning);
+        const QColor inactiveCol(isInactive ? d->buttonColors().inactive : QColor(Qt::gray));
+
+        drawDisc(painter, m_buttonStyle, backgroundColor, isInactive, inactiveCol, progress);
+
+        // render mark
+        const auto symbol = ButtonStyleEngine::symbolLayer(m_buttonStyle, type());
+        if (!symbol) return;
+
+        const auto layer = ButtonStyleEngine::discLayer(m_buttonStyle, type());
+        const bool macOSBtn(!d || m_macOSButtons
+            || (isChecked() && layer && (layer->flags & ButtonStyleEngine::CheckedMacOS)));
+
+        // in macOS mode the symbol only shows on interaction, and the disc shows the pressed state of buttons drawing it on hover only
+        const bool hoveredOnly(symbol->flags & ButtonStyleEngine::HoveredOnly);
+        if (macOSBtn)
         {
-            int gray = qGray(d->titleBarColor().rgb());
-            if (gray <= 200) {
-                gray += 55;
-                gray = qMax(gray, 115);
-            }
-            else gray -= 45;
-            inactiveCol = QColor(gray, gray, gray);
+            const bool visible = hoveredOnly ? isHovered()
+                : (isPressed() || isHovered() || (isChecked() && (symbol->flags & ButtonStyleEngine::CheckedVisible)));
+            if (!visible) return;
         }
 
-        QColor symbolColor;
-        symbolColor = QColor(34, 45, 50);
-        // render mark
-        const QColor foregroundColor(this->foregroundColor(inactiveCol));
-        if (foregroundColor.isValid())
+        if ((!macOSBtn || (isPressed() && !hoveredOnly)) && backgroundColor.isValid())
         {
+            painter->setPen(Qt::NoPen);
+            painter->setBrush(backgroundColor);
+            painter->drawEllipse(QRectF(0, 0, 18, 18));
+        }
 
-            // setup painter
-            QPen pen(symbolColor);
-            pen.setCapStyle(Qt::RoundCap);
-            pen.setJoinStyle(Qt::MiterJoin);
-            pen.setWidthF(PenWidth::Symbol*qMax((qreal)1.0, 20/width));
+        // setup painter
+        const QColor symbolColor(34, 45, 50);
+        QPen pen(symbolColor);
+        pen.setCapStyle(Qt::RoundCap);
+        pen.setJoinStyle(Qt::MiterJoin);
+        pen.setWidthF(((symbol->flags & ButtonStyleEngine::HoveredBold) && isHovered() ? 1.2 : PenWidth::Symbol)*qMax((qreal)1.0, 20/width));
 
-            switch (type())
+        painter->setPen(Qt::NoPen);
+        painter->setBrush(Qt::NoBrush);
+
+        if (symbol->flags & ButtonStyleEngine::Pin)
+        {
+            painter->setBrush(foregroundColor);
+            if (macOSBtn) painter->drawEllipse(QRectF(6, 6, 6, 6));
+            else if (isChecked())
             {
 
-                case DecorationButtonType::Close:
-                {
-                    if (!d || d->internalSettings()->macOSButtons()) {
-                        QLinearGradient grad(QPointF(9, 2), QPointF(9, 16));
-                        if (d && qGray(d->titleBarColor().rgb()) > 100)
-                        {
-                            grad.setColorAt(0, isInactive ? inactiveCol
-                            : QColor(255, 92, 87));
-                            grad.setColorAt(1, isInactive ? inactiveCol
-                            : QColor(233, 84, 79));
-                        }
-                        else
-                        {
-                            grad.setColorAt(0, isInactive ? inactiveCol
-                            : QColor(250, 100, 102));
-                            grad.setColorAt(1, isInactive ? inactiveCol
-                            : QColor(230, 92, 94));
-                        }
-                  /*      if (d && qGray(d->titleBarColor().rgb()) < 128)
-                        {
-                            grad.setColorAt(0, isInactive ? inactiveCol
-                            : QColor(255, 74, 64));
-                            grad.setColorAt(1, isInactive ? inactiveCol
-                            : QColor(255, 74, 64));
-                        }
-                        else
-                        {
-                            grad.setColorAt(0, isInactive ? inactiveCol
-                            : QColor(255, 74, 64));
-                            grad.setColorAt(1, isInactive ? inactiveCol
-                            : QColor(255, 74, 64));
-                        }*/
-
-                        QColor baseColor;
-
-                        if ( !isInactive )
-                            baseColor = QColor(255, 92, 87);
-                        else
-                            baseColor = inactiveCol;
-
-                        QRectF r(0,0, 18, 18);
-
-                        // --- Degradado principal (radial invertido) ---
-                        QRadialGradient base(r.center(), r.width()/2, QPointF(r.center().x(), r.bottom()));
-                        base.setColorAt(0.0, baseColor.lighter(110));   // parte baja brillante
-                        base.setColorAt(0.6, baseColor);
-                        base.setColorAt(1.0, baseColor.darker(110));    // borde oscuro
-                        painter->setBrush(base);
-                        painter->setPen(QColor(0,0,0,80));
-                        painter->drawEllipse(r);
-
-                        // --- Highlight superior ovalado (reflejo Aqua) ---
-                        QRectF highlightRect(r.left()+4, r.top()+1, r.width()-8, r.height()/2.5);
-                        QLinearGradient gloss(highlightRect.topLeft(), highlightRect.bottomLeft());
-                        gloss.setColorAt(0.0, QColor(255,255,255,180));
-                        gloss.setColorAt(1.0, QColor(255,255,255,0));
-                        painter->setBrush(gloss);
-                        painter->setPen(Qt::NoPen);
-                        painter->drawEllipse(highlightRect);
+                // outer ring
+                painter->drawEllipse(QRectF(3, 3, 12, 12));
 
-                        // --- Sombra inferior sutil ---
-                        QLinearGradient shadow(r.topLeft(), r.bottomLeft());
-                        shadow.setColorAt(0.0, QColor(0,0,0,0));
-                        shadow.setColorAt(1.0, QColor(0,0,0,80));
-                        painter->setBrush(shadow);
-                        painter->setPen(Qt::NoPen);
-                        painter->drawEllipse(r);
-
-                        // --- Bisel interior claro ---
-                        QRectF highlightRectb(r.left()+2, r.top()+r.height()/1.9, r.width()-4, r.height()/2.2);
-                        QRadialGradient innerHighlight(r.center(), r.width()/2, r.center());
-                        innerHighlight.setColorAt(0.0, QColor(255, 255, 255, 0));
-                        innerHighlight.setColorAt(1.0, QColor(255, 255, 255, 50));
-                        painter->setBrush(innerHighlight);
-                        painter->setPen(Qt::NoPen);
-                        painter->drawEllipse(highlightRectb);
+                // center dot
+                QColor centerColor(backgroundColor);
+                if (!centerColor.isValid() && d) centerColor = d->titleBarColor();
 
-                        if (backgroundColor.isValid())
-                        {
- /*                           QColor baseColor;
-
-                            if ( !isInactive && qGray(d->titleBarColor().rgb()) > 100 )
-                                baseColor = QColor(255, 92, 87);
-                            else if( isInactive )
-                                baseColor = inactiveCol;*/
-
-                            QRectF r(0,0, 18, 18);
-
-                            // --- Degradado principal (radial invertido) ---
-                            QRadialGradient base(r.center(), r.width()/2, QPointF(r.center().x(), r.bottom()));
-                            base.setColorAt(0.0, baseColor.lighter(110));   // parte baja brillante
-                            base.setColorAt(0.6, baseColor);
-                            base.setColorAt(1.0, baseColor.darker(110));    // borde oscuro
-                            painter->setBrush(base);
-                            painter->setPen(QColor(0,0,0,80));
-                            painter->drawEllipse(r);
-
-                            // --- Highlight superior ovalado (reflejo Aqua) ---
-                            QRectF highlightRect(r.left()+4, r.top()+1, r.width()-8, r.height()/2.5);
-                            QLinearGradient gloss(highlightRect.topLeft(), highlightRect.bottomLeft());
-                            gloss.setColorAt(0.0, QColor(255,255,255,180));
-                            gloss.setColorAt(1.0, QColor(255,255,255,0));
-                            painter->setBrush(gloss);
-                            painter->setPen(Qt::NoPen);
-                            painter->drawEllipse(highlightRect);
-
-                            // --- Sombra inferior sutil ---
-                            QLinearGradient shadow(r.topLeft(), r.bottomLeft());
-                            shadow.setColorAt(0.0, QColor(0,0,0,0));
-                            shadow.setColorAt(1.0, QColor(0,0,0,80));
-                            painter->setBrush(shadow);
-                            painter->setPen(Qt::NoPen);
-                            painter->drawEllipse(r);
-
-                            // --- Bisel interior claro ---
-                            QRectF highlightRectb(r.left()+2, r.top()+r.height()/1.9, r.width()-4, r.height()/2.2);
-                            QRadialGradient innerHighlight(r.center(), r.width()/2, r.center());
-                            innerHighlight.setColorAt(0.0, QColor(255, 255, 255, 0));
-                            innerHighlight.setColorAt(1.0, QColor(255, 255, 255, 50));
-                            painter->setBrush(innerHighlight);
-                            painter->setPen(Qt::NoPen);
-                            painter->drawEllipse(highlightRectb);
-
-                        }
-                        if (isHovered()) {
-                            painter->setPen(pen);
-                            painter->setBrush(symbolColor);
-
-                            painter->drawLine( QPointF( 6, 6 ), QPointF( 12, 12 ) );
-                            painter->drawLine( QPointF( 6, 12 ), QPointF( 12, 6 ) );
-                        }
-                    }
-                    else {
-                        if (backgroundColor.isValid())
-                        {
-                            painter->setPen(Qt::NoPen);
-                            painter->setBrush(backgroundColor);
-                            painter->drawEllipse(QRectF(0, 0, 18, 18));
-                        }
-                        painter->setPen(pen);
-                        painter->setBrush(Qt::NoBrush);
-
-                        painter->drawLine(QPointF(5, 5), QPointF(13, 13));
-                        painter->drawLine(QPointF(5, 13), QPointF(13, 5));
-                    }
-                    break;
-                }
-
-                case DecorationButtonType::Maximize:
-                {
-                    if (!d || d->internalSettings()->macOSButtons()) {
-                        QLinearGradient grad(QPointF(9, 2), QPointF(9, 16));
-                        if (d && qGray(d->titleBarColor().rgb()) < 128)
-                        {
-                            grad.setColorAt(0, isChecked() ? isInactive ? inactiveCol
-                            : QColor(67, 198, 176)
-                            : isInactive ? inactiveCol
-                            : QColor(39, 201, 63));
-                            grad.setColorAt(1, isChecked() ? isInactive ? inactiveCol
-                            : QColor(60, 178, 159)
-                            : isInactive ? inactiveCol
-                            : QColor(39, 201, 63));
-                        }
-                        else
-                        {
-                            grad.setColorAt(0, isChecked() ? isInactive ? inactiveCol
-                            : QColor(67, 198, 176)
-                            : isInactive ? inactiveCol
-                            : QColor(124, 198, 67));
-                            grad.setColorAt(1, isChecked() ? isInactive ? inactiveCol
-                            : QColor(60, 178, 159)
-                            : isInactive ? inactiveCol
-                            : QColor(111, 178, 60));
-                        }
-
-                        QColor baseColor;
-
-                        if ( !isInactive )
-                            baseColor = QColor(39, 201, 63);
-                        else
-                            baseColor = inactiveCol;
-
-                        QRectF r(0,0, 18, 18);
-
-                        // --- Degradado principal (radial invertido) ---
-                        QRadialGradient base(r.center(), r.width()/2, QPointF(r.center().x(), r.bottom()));
-                        base.setColorAt(0.0, baseColor.lighter(110));   // parte baja brillante
-                        base.setColorAt(0.6, baseColor);
-                        base.setColorAt(1.0, baseColor.darker(110));    // borde oscuro
-                        painter->setBrush(base);
-                        painter->setPen(QColor(0,0,0,80));
-                        painter->drawEllipse(r);
-
-                        // --- Highlight superior ovalado (reflejo Aqua) ---
-                        QRectF highlightRect(r.left()+4, r.top()+1, r.width()-8, r.height()/2.5);
-                        QLinearGradient gloss(highlightRect.topLeft(), highlightRect.bottomLeft());
-                        gloss.setColorAt(0.0, QColor(255,255,255,180));
-                        gloss.setColorAt(1.0, QColor(255,255,255,0));
-                        painter->setBrush(gloss);
-                        painter->setPen(Qt::NoPen);
-                        painter->drawEllipse(highlightRect);
-
-                        // --- Sombra inferior sutil ---
-                        QLinearGradient shadow(r.topLeft(), r.bottomLeft());
-                        shadow.setColorAt(0.0, QColor(0,0,0,0));
-                        shadow.setColorAt(1.0, QColor(0,0,0,80));
-                        painter->setBrush(shadow);
-                        painter->setPen(Qt::NoPen);
-                        painter->drawEllipse(r);
-
-                        // --- Bisel interior claro ---
-                        QRectF highlightRectb(r.left()+2, r.top()+r.height()/1.9, r.width()-4, r.height()/2.2);
-                        QRadialGradient innerHighlight(r.center(), r.width()/2, r.center());
-                        innerHighlight.setColorAt(0.0, QColor(255, 255, 255, 0));
-                        innerHighlight.setColorAt(1.0, QColor(255, 255, 255, 50));
-                        painter->setBrush(innerHighlight);
-                        painter->setPen(Qt::NoPen);
-                        painter->drawEllipse(highlightRectb);
-
-                        if (backgroundColor.isValid())
-                        {
-
-                            QRectF r(0,0, 18, 18);
-
-                            // --- Degradado principal (radial invertido) ---
-                            QRadialGradient base(r.center(), r.width()/2, QPointF(r.center().x(), r.bottom()));
-                            base.setColorAt(0.0, baseColor.lighter(110));   // parte baja brillante
-                            base.setColorAt(0.6, baseColor);
-                            base.setColorAt(1.0, baseColor.darker(110));    // borde oscuro
-                            painter->setBrush(base);
-                            painter->setPen(QColor(0,0,0,80));
-                            painter->drawEllipse(r);
-
-                            // --- Highlight superior ovalado (reflejo Aqua) ---
-                            QRectF highlightRect(r.left()+4, r.top()+1, r.width()-8, r.height()/2.5);
-                            QLinearGradient gloss(highlightRect.topLeft(), highlightRect.bottomLeft());
-                            gloss.setColorAt(0.0, QColor(255,255,255,180));
-                            gloss.setColorAt(1.0, QColor(255,255,255,0));
-                            painter->setBrush(gloss);
-                            painter->setPen(Qt::NoPen);
-                            painter->drawEllipse(highlightRect);
-
-                            // --- Sombra inferior sutil ---
-                            QLinearGradient shadow(r.topLeft(), r.bottomLeft());
-                            shadow.setColorAt(0.0, QColor(0,0,0,0));
-                            shadow.setColorAt(1.0, QColor(0,0,0,80));
-                            painter->setBrush(shadow);
-                            painter->setPen(Qt::NoPen);
-                            painter->drawEllipse(r);
-
-                            // --- Bisel interior claro ---
-                            QRectF highlightRectb(r.left()+2, r.top()+r.height()/1.9, r.width()-4, r.height()/2.2);
-                            QRadialGradient innerHighlight(r.center(), r.width()/2, r.center());
-                            innerHighlight.setColorAt(0.0, QColor(255, 255, 255, 0));
-                            innerHighlight.setColorAt(1.0, QColor(255, 255, 255, 50));
-                            painter->setBrush(innerHighlight);
-                            painter->setPen(Qt::NoPen);
-                            painter->drawEllipse(highlightRectb);
-                        }
-                        if (isHovered()) {
-                            painter->setPen( Qt::NoPen );
-
-                            // two triangles
-                            QPainterPath path1, path2;
-                            if( isChecked() )
-                            {
-                                path1.moveTo(8.5, 9.5);
-                                path1.lineTo(2.5, 9.5);
-                                path1.lineTo(8.5, 15.5);
-
-                                path2.moveTo(9.5, 8.5);
-                                path2.lineTo(15.5, 8.5);
-                                path2.lineTo(9.5, 2.5);
-                            }
-                            else
-                            {
-                                path1.moveTo(5, 13);
-                                path1.lineTo(11, 13);
-                                path1.lineTo(5, 7);
-
-                                path2.moveTo(13, 5);
-                                path2.lineTo(7, 5);
-                                path2.lineTo(13, 11);
-                            }
-
-                            painter->fillPath(path1, QBrush(symbolColor));
-                            painter->fillPath(path2, QBrush(symbolColor));
-                        }
-                    }
-                    else {
-                        if (backgroundColor.isValid())
-                        {
-                            painter->setPen(Qt::NoPen);
-                            painter->setBrush(backgroundColor);
-                            painter->drawEllipse(QRectF(0, 0, 18, 18));
-                        }
-
-                        if (isHovered())
-                            pen.setWidthF(1.2*qMax((qreal)1.0, 20/width));
-                        painter->setPen(pen);
-                        painter->setBrush(Qt::NoBrush);
-
-                        painter->drawPolyline(QPolygonF()
-                        << QPointF(5, 8) << QPointF(5, 13) << QPointF(10, 13));
-                        if (isChecked())
-                            painter->drawRect(QRectF(8.0, 5.0, 5.0, 5.0));
-                        else {
-                            painter->drawPolyline(QPolygonF()
-                            << QPointF(8, 5) << QPointF(13, 5) << QPointF(13, 10));
-                        }
-
-                        if (isHovered())
-                            pen.setWidthF(PenWidth::Symbol*qMax((qreal)1.0, 20/width));
-                    }
-                    break;
-                }
-
-                case DecorationButtonType::Minimize:
-                {
-                    if (!d || d->internalSettings()->macOSButtons()) {
-                        QLinearGradient grad(QPointF(9, 2), QPointF(9, 16));
-                        if (d && qGray(d->titleBarColor().rgb()) < 128)
-                        { // yellow isn't good with light backgrounds
-                            grad.setColorAt(0, isInactive ? inactiveCol
-                            : QColor(255, 189, 46));
-                            grad.setColorAt(1, isInactive ? inactiveCol
-                            : QColor(255, 189, 46));
-                        }
-                        else
-                        {
-                            grad.setColorAt(0, isInactive ? inactiveCol
-                            : QColor(255, 189, 46));
-                            grad.setColorAt(1, isInactive ? inactiveCol
-                            : QColor(255, 189, 46));
-                        }
-
-                        QColor baseColor;
-
-                        if ( !isInactive )
-                            baseColor = QColor(255, 189, 46);
-                        else
-                            baseColor = inactiveCol;
-
-                        QRectF r(0,0, 18, 18);
-
-                        // --- Degradado principal (radial invertido) ---
-                        QRadialGradient base(r.center(), r.width()/2, QPointF(r.center().x(), r.bottom()));
-                        base.setColorAt(0.0, baseColor.lighter(110));   // parte baja brillante
-                        base.setColorAt(0.6, baseColor);
-                        base.setColorAt(1.0, baseColor.darker(110));    // borde oscuro
-                        painter->setBrush(base);
-                        painter->setPen(QColor(0,0,0,80));
-                        painter->drawEllipse(r);
-
-                        // --- Highlight superior ovalado (reflejo Aqua) ---
-                        QRectF highlightRect(r.left()+4, r.top()+1, r.width()-8, r.height()/2.5);
-                        QLinearGradient gloss(highlightRect.topLeft(), highlightRect.bottomLeft());
-                        gloss.setColorAt(0.0, QColor(255,255,255,180));
-                        gloss.setColorAt(1.0, QColor(255,255,255,0));
-                        painter->setBrush(gloss);
-                        painter->setPen(Qt::NoPen);
-                        painter->drawEllipse(highlightRect);
-
-                        // --- Sombra inferior sutil ---
-                        QLinearGradient shadow(r.topLeft(), r.bottomLeft());
-                        shadow.setColorAt(0.0, QColor(0,0,0,0));
-                        shadow.setColorAt(1.0, QColor(0,0,0,80));
-                        painter->setBrush(shadow);
-                        painter->setPen(Qt::NoPen);
-                        painter->drawEllipse(r);
-
-                        // --- Bisel interior claro ---
-                        QRectF highlightRectb(r.left()+2, r.top()+r.height()/1.9, r.width()-4, r.height()/2.2);
-                        QRadialGradient innerHighlight(r.center(), r.width()/2, r.center());
-                        innerHighlight.setColorAt(0.0, QColor(255, 255, 255, 0));
-                        innerHighlight.setColorAt(1.0, QColor(255, 255, 255, 50));
-                        painter->setBrush(innerHighlight);
-                        painter->setPen(Qt::NoPen);
-                        painter->drawEllipse(highlightRectb);
-
-                        if (backgroundColor.isValid())
-                        {
-
-                            QRectF r(0,0, 18, 18);
-
-                            // --- Degradado principal (radial invertido) ---
-                            QRadialGradient base(r.center(), r.width()/2, QPointF(r.center().x(), r.bottom()));
-                            base.setColorAt(0.0, baseColor.lighter(110));   // parte baja brillante
-                            base.setColorAt(0.6, baseColor);
-                            base.setColorAt(1.0, baseColor.darker(110));    // borde oscuro
-                            painter->setBrush(base);
-                            painter->setPen(QColor(0,0,0,80));
-                            painter->drawEllipse(r);
-
-                            // --- Highlight superior ovalado (reflejo Aqua) ---
-                            QRectF highlightRect(r.left()+4, r.top()+1, r.width()-8, r.height()/2.5);
-                            QLinearGradient gloss(highlightRect.topLeft(), highlightRect.bottomLeft());
-                            gloss.setColorAt(0.0, QColor(255,255,255,180));
-                            gloss.setColorAt(1.0, QColor(255,255,255,0));
-                            painter->setBrush(gloss);
-                            painter->setPen(Qt::NoPen);
-                            painter->drawEllipse(highlightRect);
-
-                            // --- Sombra inferior sutil ---
-                            QLinearGradient shadow(r.topLeft(), r.bottomLeft());
-                            shadow.setColorAt(0.0, QColor(0,0,0,0));
-                            shadow.setColorAt(1.0, QColor(0,0,0,80));
-                            painter->setBrush(shadow);
-                            painter->setPen(Qt::NoPen);
-                            painter->drawEllipse(r);
-
-                            // --- Bisel interior claro ---
-                            QRectF highlightRectb(r.left()+2, r.top()+r.height()/1.9, r.width()-4, r.height()/2.2);
-                            QRadialGradient innerHighlight(r.center(), r.width()/2, r.center());
-                            innerHighlight.setColorAt(0.0, QColor(255, 255, 255, 0));
-                            innerHighlight.setColorAt(1.0, QColor(255, 255, 255, 50));
-                            painter->setBrush(innerHighlight);
-                            painter->setPen(Qt::NoPen);
-                            painter->drawEllipse(highlightRectb);
-                        }
-                        if (isHovered()) {
-                            pen.setWidthF(1.2*qMax((qreal)1.0, 20/width));
-                            painter->setPen(pen);
-                            painter->setBrush(symbolColor);
-                            painter->drawLine( QPointF( 5, 9 ), QPointF( 13, 9 ) );
-                        }
-                    }
-                    else {
-                        if (backgroundColor.isValid())
-                        {
-                            painter->setPen(Qt::NoPen);
-                            painter->setBrush(backgroundColor);
-                            painter->drawEllipse(QRectF(0, 0, 18, 18));
-                        }
-
-                        if (isHovered())
-                            pen.setWidthF(1.2*qMax((qreal)1.0, 20/width));
-                        painter->setPen(pen);
-                        painter->setBrush(Qt::NoBrush);
-
-                        painter->drawLine(QPointF(4, 9), QPointF(14, 9));
-
-                        if (isHovered())
-                            pen.setWidthF(PenWidth::Symbol*qMax((qreal)1.0, 20/width));
-                    }
-                    break;
-                }
-
-                case DecorationButtonType::OnAllDesktops:
-                {
-                    bool macOSBtn(!d || d->internalSettings()->macOSButtons());
-                    if (macOSBtn && !isPressed()) {
-                        QLinearGradient grad(QPointF(9, 2), QPointF(9, 16));
-                        if (d && qGray(d->titleBarColor().rgb()) > 100)
-                        { // yellow isn't good with light backgrounds
-                            grad.setColorAt(0, isInactive ? inactiveCol
-                            : QColor(103, 149, 210));
-                            grad.setColorAt(1, isInactive ? inactiveCol
-                            : QColor(93, 135, 190));
-                        }
-                        else
-                        {
-                            grad.setColorAt(0, isInactive ? inactiveCol
-                            : QColor(135, 166, 220));
-                            grad.setColorAt(1, isInactive ? inactiveCol
-                            : QColor(122, 151, 200));
-                        }
-                        painter->setBrush(QBrush(grad));
-                        painter->setPen(Qt::NoPen);
-                        if (isChecked())
-                            painter->drawEllipse(QRectF(0, 0, 18, 18));
-                        else {
-                            painter->drawEllipse(QRectF(1, 1, 16, 16));
-                            if (backgroundColor.isValid())
-                            {
-                                painter->setPen(Qt::NoPen);
-                                painter->setBrush(backgroundColor);
-                                qreal r = static_cast<qreal>(7)
-                                + static_cast<qreal>(2) * m_animation->currentValue().toReal();
-                                QPointF c(static_cast<qreal>(9), static_cast<qreal>(9));
-                                painter->drawEllipse(c, r, r);
-                            }
-                        }
-                    }
-                    if (!macOSBtn || isPressed() || isHovered() || isChecked()) {
-                        painter->setPen(Qt::NoPen);
-                        if ((!macOSBtn  || isPressed()) && backgroundColor.isValid())
-                        {
-                            painter->setBrush(backgroundColor);
-                            painter->drawEllipse(QRectF(0, 0, 18, 18));
-                        }
-                        painter->setBrush(foregroundColor);
-
-                        if (macOSBtn)
-                            painter->drawEllipse(QRectF(6, 6, 6, 6));
-                        else {
-                            if (isChecked()) {
-
-                                // outer ring
-                                painter->drawEllipse(QRectF(3, 3, 12, 12));
-
-                                // center dot
-                                QColor backgroundColor(this->backgroundColor());
-                                if (!backgroundColor.isValid() && d) backgroundColor = d->titleBarColor();
-
-                                if (backgroundColor.isValid())
-                                {
-                                    painter->setBrush(backgroundColor);
-                                    painter->drawEllipse(QRectF(8, 8, 2, 2));
-                                }
-
-                            }
-                            else {
-                                painter->drawPolygon(QPolygonF()
-                                << QPointF(6.5, 8.5)
-                                << QPointF(12, 3)
-                                << QPointF(15, 6)
-                                << QPointF(9.5, 11.5));
-
-                                painter->setPen(pen);
-                                painter->drawLine(QPointF(5.5, 7.5), QPointF(10.5, 12.5));
-                                painter->drawLine(QPointF(12, 6), QPointF(4.5, 13.5));
-                            }
-                        }
-                    }
-                    break;
-                }
-
-                case DecorationButtonType::Shade:
-                {
-                    bool macOSBtn(!d || d->internalSettings()->macOSButtons());
-                    if (macOSBtn && !isPressed()) {
-                        QLinearGradient grad(QPointF(9, 2), QPointF(9, 16));
-                        if (d && qGray(d->titleBarColor().rgb()) > 100)
-                        { // yellow isn't good with light backgrounds
-                            grad.setColorAt(0, isInactive ? inactiveCol
-                            : QColor(103, 149, 210));
-                            grad.setColorAt(1, isInactive ? inactiveCol
-                            : QColor(93, 135, 190));
-                        }
-                        else
-                        {
-                            grad.setColorAt(0, isInactive ? inactiveCol
-                            : QColor(135, 166, 220));
-                            grad.setColorAt(1, isInactive ? inactiveCol
-                            : QColor(122, 151, 200));
-                        }
-                        painter->setBrush(QBrush(grad));
-                        painter->setPen(Qt::NoPen);
-                        if (isChecked())
-                            painter->drawEllipse(QRectF(0, 0, 18, 18));
-                        else {
-                            painter->drawEllipse(QRectF(1, 1, 16, 16));
-                            if (backgroundColor.isValid())
-                            {
-                                painter->setPen(Qt::NoPen);
-                                painter->setBrush(backgroundColor);
-                                qreal r = static_cast<qreal>(7)
-                                + static_cast<qreal>(2) * m_animation->currentValue().toReal();
-                                QPointF c(static_cast<qreal>(9), static_cast<qreal>(9));
-                                painter->drawEllipse(c, r, r);
-                            }
-                        }
-                    }
-                    if (!macOSBtn || isPressed() || isHovered() || isChecked()) {
-                        if ((!macOSBtn  || isPressed()) && backgroundColor.isValid())
-                        {
-                            painter->setPen(Qt::NoPen);
-                            painter->setBrush(backgroundColor);
-                            painter->drawEllipse(QRectF(0, 0, 18, 18));
-                        }
-                        painter->setPen(pen);
-                        painter->setBrush(Qt::NoBrush);
-
-                        painter->drawLine(5, 6, 13, 6);
-                        if (isChecked()) {
-                            painter->drawPolyline(QPolygonF()
-                            << QPointF(5, 9)
-                            << QPointF(9, 13)
-                            << QPointF(13, 9));
-
-                        }
-                        else {
-                            painter->drawPolyline(QPolygonF()
-                            << QPointF(5, 13)
-                            << QPointF(9, 9)
-                            << QPointF(13, 13));
-                        }
-                    }
-
-                    break;
-
-                }
-
-                case DecorationButtonType::KeepBelow:
-                {
-                    bool macOSBtn(!d || d->internalSettings()->macOSButtons() || isChecked());
-                    if (macOSBtn && !isPressed()) {
-                        QLinearGradient grad(QPointF(9, 2), QPointF(9, 16));
-                        if (d && qGray(d->titleBarColor().rgb()) > 100)
-                        { // yellow isn't good with light backgrounds
-                            grad.setColorAt(0, isInactive ? inactiveCol
-                            : QColor(103, 149, 210));
-                            grad.setColorAt(1, isInactive ? inactiveCol
-                            : QColor(93, 135, 190));
-                        }
-                        else
-                        {
-                            grad.setColorAt(0, isInactive ? inactiveCol
-                            : QColor(135, 166, 220));
-                            grad.setColorAt(1, isInactive ? inactiveCol
-                            : QColor(122, 151, 200));
-                        }
-                        painter->setBrush(QBrush(grad));
-                        painter->setPen(Qt::NoPen);
-                        if (isChecked())
-                            painter->drawEllipse(QRectF(0, 0, 18, 18));
-                        else {
-                            painter->drawEllipse(QRectF(1, 1, 16, 16));
-                            if (backgroundColor.isValid())
-                            {
-                                painter->setPen(Qt::NoPen);
-                                painter->setBrush(backgroundColor);
-                                qreal r = static_cast<qreal>(7)
-                                + static_cast<qreal>(2) * m_animation->currentValue().toReal();
-                                QPointF c(static_cast<qreal>(9), static_cast<qreal>(9));
-                                painter->drawEllipse(c, r, r);
-                            }
-                        }
-                    }
-                    if (!macOSBtn || isPressed() || isHovered() || isChecked()) {
-                        if ((!macOSBtn  || isPressed()) && backgroundColor.isValid())
-                        {
-                            painter->setPen(Qt::NoPen);
-                            painter->setBrush(backgroundColor);
-                            painter->drawEllipse(QRectF(0, 0, 18, 18));
-                        }
-                        painter->setPen(pen);
-                        painter->setBrush(Qt::NoBrush);
-
-                        if (macOSBtn) {
-                            painter->drawPolyline(QPolygonF()
-                            << QPointF(6, 6)
-                            << QPointF(9, 9)
-                            << QPointF(12, 6));
-
-                            painter->drawPolyline(QPolygonF()
-                            << QPointF(6, 10)
-                            << QPointF(9, 13)
-                            << QPointF(12, 10));
-                        }
-                        else {
-                            painter->drawPolyline(QPolygonF()
-                            << QPointF(5, 5)
-                            << QPointF(9, 9)
-                            << QPointF(13, 5));
-
-                            painter->drawPolyline(QPolygonF()
-                            << QPointF(5, 9)
-                            << QPointF(9, 13)
-                            << QPointF(13, 9));
-                        }
-                    }
-                    break;
-
-                }
-
-                case DecorationButtonType::KeepAbove:
-                {
-                    bool macOSBtn(!d || d->internalSettings()->macOSButtons());
-                    if (macOSBtn && !isPressed()) {
-                        QLinearGradient grad(QPointF(9, 2), QPointF(9, 16));
-                        if (d && qGray(d->titleBarColor().rgb()) > 100)
-                        { // yellow isn't good with light backgrounds
-                            grad.setColorAt(0, isInactive ? inactiveCol
-                            : QColor(103, 149, 210));
-                            grad.setColorAt(1, isInactive ? inactiveCol
-                            : QColor(93, 135, 190));
-                        }
-                        else
-                        {
-                            grad.setColorAt(0, isInactive ? inactiveCol
-                            : QColor(135, 166, 220));
-                            grad.setColorAt(1, isInactive ? inactiveCol
-                            : QColor(122, 151, 200));
-                        }
-                        painter->setBrush(QBrush(grad));
-                        painter->setPen(Qt::NoPen);
-                        if (isChecked())
-                            painter->drawEllipse(QRectF(0, 0, 18, 18));
-                        else {
-                            painter->drawEllipse(QRectF(1, 1, 16, 16));
-                            if (backgroundColor.isValid())
-                            {
-                                painter->setPen(Qt::NoPen);
-                                painter->setBrush(backgroundColor);
-                                qreal r = static_cast<qreal>(7)
-                                + static_cast<qreal>(2) * m_animation->currentValue().toReal();
-                                QPointF c(static_cast<qreal>(9), static_cast<qreal>(9));
-                                painter->drawEllipse(c, r, r);
-                            }
-                        }
-                    }
-                    if (!macOSBtn || isPressed() || isHovered() || isChecked()) {
-                        if ((!macOSBtn  || isPressed()) && backgroundColor.isValid())
-                        {
-                            painter->setPen(Qt::NoPen);
-                            painter->setBrush(backgroundColor);
-                            painter->drawEllipse(QRectF(0, 0, 18, 18));
-                        }
-                        painter->setPen(pen);
-                        painter->setBrush(Qt::NoBrush);
-
-                        if (macOSBtn) {
-                            painter->drawPolyline(QPolygonF()
-                            << QPointF(6, 8)
-                            << QPointF(9, 5)
-                            << QPointF(12, 8));
-
-                            painter->drawPolyline(QPolygonF()
-                            << QPointF(6, 12)
-                            << QPointF(9, 9)
-                            << QPointF(12, 12));
-                        }
-                        else {
-                            painter->drawPolyline(QPolygonF()
-                            << QPointF(5, 9)
-                            << QPointF(9, 5)
-                            << QPointF(13, 9));
-
-                            painter->drawPolyline(QPolygonF()
-                            << QPointF(5, 13)
-                            << QPointF(9, 9)
-                            << QPointF(13, 13));
-                        }
-                    }
-                    break;
-                }
-
-
-                case DecorationButtonType::ApplicationMenu:
-                {
-                    bool macOSBtn(!d || d->internalSettings()->macOSButtons());
-                    if (macOSBtn && !isPressed()) {
-                        QLinearGradient grad(QPointF(9, 2), QPointF(9, 16));
-                        if (d && qGray(d->titleBarColor().rgb()) > 100)
-                        { // yellow isn't good with light backgrounds
-                            grad.setColorAt(0, isInactive ? inactiveCol
-                            : QColor(230, 129, 67));
-                            grad.setColorAt(1, isInactive ? inactiveCol
-                            : QColor(210, 118, 61));
-                        }
-                        else
-                        {
-                            grad.setColorAt(0, isInactive ? inactiveCol
-                            : QColor(250, 145, 100));
-                            grad.setColorAt(1, isInactive ? inactiveCol
-                            : QColor(230, 131, 92));
-                        }
-                        painter->setBrush(QBrush(grad));
-                        painter->setPen(Qt::NoPen);
-                        painter->drawEllipse(QRectF(1, 1, 16, 16));
-                        if (backgroundColor.isValid())
-                        {
-                            painter->setPen(Qt::NoPen);
-                            painter->setBrush(backgroundColor);
-                            qreal r = static_cast<qreal>(7)
-                            + static_cast<qreal>(2) * m_animation->currentValue().toReal();
-                            QPointF c(static_cast<qreal>(9), static_cast<qreal>(9));
-                            painter->drawEllipse(c, r, r);
-                        }
-                    }
-                    if (!macOSBtn || isPressed() || isHovered()) {
-                        if ((!macOSBtn  || isPressed()) && backgroundColor.isValid())
-                        {
-                            painter->setPen(Qt::NoPen);
-                            painter->setBrush(backgroundColor);
-                            painter->drawEllipse(QRectF(0, 0, 18, 18));
-                        }
-                        painter->setPen(pen);
-                        painter->setBrush(Qt::NoBrush);
-
-                        if (macOSBtn) {
-                            painter->drawLine(QPointF(4.5, 6), QPointF(13.5, 6));
-                            painter->drawLine(QPointF(4.5, 9), QPointF(13.5, 9));
-                            painter->drawLine(QPointF(4.5, 12), QPointF(13.5, 12));
-                        }
-                        else {
-                            painter->drawLine(QPointF(3.5, 5), QPointF(14.5, 5));
-                            painter->drawLine(QPointF(3.5, 9), QPointF(14.5, 9));
-                            painter->drawLine(QPointF(3.5, 13), QPointF(14.5, 13));
-                        }
-                    }
-                    break;
-                }
-
-                case DecorationButtonType::ContextHelp:
-                {
-                    bool macOSBtn(!d || d->internalSettings()->macOSButtons());
-                    if (macOSBtn && !isPressed()) {
-                        QLinearGradient grad(QPointF(9, 2), QPointF(9, 16));
-                        if (d && qGray(d->titleBarColor().rgb()) > 100)
-                        { // yellow isn't good with light backgrounds
-                            grad.setColorAt(0, isInactive ? inactiveCol
-                            : QColor(103, 149, 210));
-                            grad.setColorAt(1, isInactive ? inactiveCol
-                            : QColor(93, 135, 190));
-                        }
-                        else
-                        {
-                            grad.setColorAt(0, isInactive ? inactiveCol
-                            : QColor(135, 166, 220));
-                            grad.setColorAt(1, isInactive ? inactiveCol
-                            : QColor(122, 151, 200));
-                        }
-                        painter->setBrush(QBrush(grad));
-                        painter->setPen(Qt::NoPen);
-                        painter->drawEllipse(QRectF(1, 1, 16, 16));
-                        if (backgroundColor.isValid())
-                        {
-                            painter->setPen(Qt::NoPen);
-                            painter->setBrush(backgroundColor);
-                            qreal r = static_cast<qreal>(7)
-                            + static_cast<qreal>(2) * m_animation->currentValue().toReal();
-                            QPointF c(static_cast<qreal>(9), static_cast<qreal>(9));
-                            painter->drawEllipse(c, r, r);
-                        }
-                    }
-                    if (!macOSBtn || isPressed() || isHovered()) {
-                        if ((!macOSBtn  || isPressed()) && backgroundColor.isValid())
-                        {
-                            painter->setPen(Qt::NoPen);
-                            painter->setBrush(backgroundColor);
-                            painter->drawEllipse(QRectF(0, 0, 18, 18));
-                        }
-                        painter->setPen(pen);
-                        painter->setBrush(Qt::NoBrush);
-
-                        QPainterPath path;
-                        path.moveTo(5, 6);
-                        path.arcTo(QRectF(5, 3.5, 8, 5), 180, -180);
-                        path.cubicTo(QPointF(12.5, 9.5), QPointF(9, 7.5), QPointF(9, 11.5));
-                        painter->drawPath(path);
-
-                        painter->drawPoint(9, 15);
-                    }
-
-                    break;
-                }
-
-                default: break;
-
-            }
-
-        }
-
-    }
-
-    //__________________________________________________________________
-    void Button::drawIconMacSierra(QPainter *painter) const
-    {
-
-        painter->setRenderHints(QPainter::Antialiasing);
-
-        /*
-         *   scale painter so that its window matches QRect(-1, -1, 20, 20)
-         *   this makes all further rendering and scaling simpler
-         *   all further rendering is performed inside QRect(0, 0, 18, 18)
-         */
-        const QRectF rect = geometry().marginsRemoved(m_padding);
-        painter->translate(rect.topLeft());
-
-        const qreal width(rect.width());
-        painter->scale(width/20, width/20);
-        painter->translate(1, 1);
-
-        // render background
-        const QColor backgroundColor(this->backgroundColor());
-
-        auto d = qobject_cast<Decoration*>(decoration());
-        bool isInactive(d && !d->window()->isActive()
-        && !isHovered() && !isPressed()
-        && m_animation->state() != QAbstractAnimation::Running);
-        QColor inactiveCol(Qt::gray);
-        if (isInactive)
-        {
-            int gray = qGray(d->titleBarColor().rgb());
-            if (gray <= 200) {
-                gray += 55;
-                gray = qMax(gray, 115);
-            }
-            else gray -= 45;
-            inactiveCol = QColor(gray, gray, gray);
-        }
-
-        QColor symbolColor;
-        symbolColor = QColor(34, 45, 50);
-        // render mark
-        const QColor foregroundColor(this->foregroundColor(inactiveCol));
-        if (foregroundColor.isValid())
-        {
-
-            // setup painter
-            QPen pen(symbolColor);
-            pen.setCapStyle(Qt::RoundCap);
-            pen.setJoinStyle(Qt::MiterJoin);
-            pen.setWidthF(PenWidth::Symbol*qMax((qreal)1.0, 20/width));
-
-            switch (type())
-            {
-
-                case DecorationButtonType::Close:
-                {
-                    if (!d || d->internalSettings()->macOSButtons()) {
-                        QLinearGradient grad(QPointF(9, 2), QPointF(9, 16));
-                        if (d && qGray(d->titleBarColor().rgb()) < 128)
-                        {
-                            grad.setColorAt(0, isInactive ? inactiveCol
-                            : QColor(255, 92, 87));
-                            grad.setColorAt(1, isInactive ? inactiveCol
-                            : QColor(233, 84, 79));
-                        }
-                        else
-                        {
-                            grad.setColorAt(0, isInactive ? inactiveCol
-                            : QColor(250, 100, 102));
-                            grad.setColorAt(1, isInactive ? inactiveCol
-                            : QColor(230, 92, 94));
-                        }
-                        painter->setBrush(QBrush(grad));
-                        painter->setPen(Qt::NoPen);
-                        painter->drawEllipse(QRectF(1, 1, 16, 16));
-                        if (backgroundColor.isValid())
-                        {
-                            painter->setPen(Qt::NoPen);
-                            painter->setBrush(backgroundColor);
-                            qreal r = static_cast<qreal>(7)
-                            + (isPressed() ? 0.0
-                            : static_cast<qreal>(2) * m_animation->currentValue().toReal());
-                            QPointF c(static_cast<qreal>(9), static_cast<qreal>(9));
-                            painter->drawEllipse(c, r, r);
-                        }
-                        if (isHovered()) {
-                            painter->setPen(pen);
-                            painter->setBrush(symbolColor);
-
-                            painter->drawLine( QPointF( 6, 6 ), QPointF( 12, 12 ) );
-                            painter->drawLine( QPointF( 6, 12 ), QPointF( 12, 6 ) );
-                        }
-                    }
-                    else {
-                        if (backgroundColor.isValid())
-                        {
-                            painter->setPen(Qt::NoPen);
-                            painter->setBrush(backgroundColor);
-                            painter->drawEllipse(QRectF(0, 0, 18, 18));
-                        }
-                        painter->setPen(pen);
-                        painter->setBrush(Qt::NoBrush);
-
-                        painter->drawLine(QPointF(5, 5), QPointF(13, 13));
-                        painter->drawLine(QPointF(5, 13), QPointF(13, 5));
-                    }
-                    break;
-                }
-
-                case DecorationButtonType::Maximize:
-                {
-                    if (!d || d->internalSettings()->macOSButtons()) {
-                        QLinearGradient grad(QPointF(9, 2), QPointF(9, 16));
-                        if (d && qGray(d->titleBarColor().rgb()) < 128)
-                        {
-                            grad.setColorAt(0, isChecked() ? isInactive ? inactiveCol
-                            : QColor(67, 198, 176)
-                            : isInactive ? inactiveCol
-                            : QColor(40, 211, 63));
-                            grad.setColorAt(1, isChecked() ? isInactive ? inactiveCol
-                            : QColor(60, 178, 159)
-                            : isInactive ? inactiveCol
-                            : QColor(36, 191, 57));
-                        }
-                        else
-                        {
-                            grad.setColorAt(0, isChecked() ? isInactive ? inactiveCol
-                            : QColor(67, 198, 176)
-                            : isInactive ? inactiveCol
-                            : QColor(124, 198, 67));
-                            grad.setColorAt(1, isChecked() ? isInactive ? inactiveCol
-                            : QColor(60, 178, 159)
-                            : isInactive ? inactiveCol
-                            : QColor(111, 178, 60));
-                        }
-                        painter->setBrush(QBrush(grad));
-                        painter->setPen(Qt::NoPen);
-                        painter->drawEllipse(QRectF(1, 1, 16, 16));
-                        if (backgroundColor.isValid())
-                        {
-                            painter->setPen(Qt::NoPen);
-                            painter->setBrush(backgroundColor);
-                            qreal r = static_cast<qreal>(7)
-                            + (isPressed() ? 0.0
-                            : static_cast<qreal>(2) * m_animation->currentValue().toReal());
-                            QPointF c(static_cast<qreal>(9), static_cast<qreal>(9));
-                            painter->drawEllipse(c, r, r);
-                        }
-                        if (isHovered()) {
-                            painter->setPen( Qt::NoPen );
-
-                            // two triangles
-                            QPainterPath path1, path2;
-                            if( isChecked() )
-                            {
-                                path1.moveTo(8.5, 9.5);
-                                path1.lineTo(2.5, 9.5);
-                                path1.lineTo(8.5, 15.5);
-
-                                path2.moveTo(9.5, 8.5);
-                                path2.lineTo(15.5, 8.5);
-                                path2.lineTo(9.5, 2.5);
-                            }
-                            else
-                            {
-                                path1.moveTo(5, 13);
-                                path1.lineTo(11, 13);
-                                path1.lineTo(5, 7);
-
-                                path2.moveTo(13, 5);
-                                path2.lineTo(7, 5);
-                                path2.lineTo(13, 11);
-                            }
-
-                            painter->fillPath(path1, QBrush(symbolColor));
-                            painter->fillPath(path2, QBrush(symbolColor));
-                        }
-                    }
-                    else {
-                        if (backgroundColor.isValid())
-                        {
-                            painter->setPen(Qt::NoPen);
-                            painter->setBrush(backgroundColor);
-                            painter->drawEllipse(QRectF(0, 0, 18, 18));
-                        }
-
-                        if (isHovered())
-                            pen.setWidthF(1.2*qMax((qreal)1.0, 20/width));
-                        painter->setPen(pen);
-                        painter->setBrush(Qt::NoBrush);
-
-                        painter->drawPolyline(QPolygonF()
-                        << QPointF(5, 8) << QPointF(5, 13) << QPointF(10, 13));
-                        if (isChecked())
-                            painter->drawRect(QRectF(8.0, 5.0, 5.0, 5.0));
-                        else {
-                            painter->drawPolyline(QPolygonF()
-                            << QPointF(8, 5) << QPointF(13, 5) << QPointF(13, 10));
-                        }
-
-                        if (isHovered())
-                            pen.setWidthF(PenWidth::Symbol*qMax((qreal)1.0, 20/width));
-                    }
-                    break;
-                }
-
-                case DecorationButtonType::Minimize:
-                {
-                    if (!d || d->internalSettings()->macOSButtons()) {
-                        QLinearGradient grad(QPointF(9, 2), QPointF(9, 16));
-                        if (d && qGray(d->titleBarColor().rgb()) < 128)
-                        { // yellow isn't good with light backgrounds
-                            grad.setColorAt(0, isInactive ? inactiveCol
-                            : QColor(243, 176, 43));
-                            grad.setColorAt(1, isInactive ? inactiveCol
-                            : QColor(223, 162, 39));
-                        }
-                        else
-                        {
-                            grad.setColorAt(0, isInactive ? inactiveCol
-                            : QColor(237, 198, 81));
-                            grad.setColorAt(1, isInactive ? inactiveCol
-                            : QColor(217, 181, 74));
-                        }
-                        painter->setBrush(QBrush(grad));
-                        painter->setPen(Qt::NoPen);
-                        painter->drawEllipse(QRectF(1, 1, 16, 16));
-                        if (backgroundColor.isValid())
-                        {
-                            painter->setPen(Qt::NoPen);
-                            painter->setBrush(backgroundColor);
-                            qreal r = static_cast<qreal>(7)
-                            + (isPressed() ? 0.0
-                            : static_cast<qreal>(2) * m_animation->currentValue().toReal());
-                            QPointF c(static_cast<qreal>(9), static_cast<qreal>(9));
-                            painter->drawEllipse(c, r, r);
-                        }
-                        if (isHovered()) {
-                            pen.setWidthF(1.2*qMax((qreal)1.0, 20/width));
-                            painter->setPen(pen);
-                            painter->setBrush(symbolColor);
-                            painter->drawLine( QPointF( 5, 9 ), QPointF( 13, 9 ) );
-                        }
-                    }
-                    else {
-                        if (backgroundColor.isValid())
-                        {
-                            painter->setPen(Qt::NoPen);
-                            painter->setBrush(backgroundColor);
-                            painter->drawEllipse(QRectF(0, 0, 18, 18));
-                        }
-
-                        if (isHovered())
-                            pen.setWidthF(1.2*qMax((qreal)1.0, 20/width));
-                        painter->setPen(pen);
-                        painter->setBrush(Qt::NoBrush);
-
-                        painter->drawLine(QPointF(4, 9), QPointF(14, 9));
-
-                        if (isHovered())
-                            pen.setWidthF(PenWidth::Symbol*qMax((qreal)1.0, 20/width));
-                    }
-                    break;
-                }
-
-                case DecorationButtonType::OnAllDesktops:
-                {
-                    bool macOSBtn(!d || d->internalSettings()->macOSButtons());
-                    if (macOSBtn && !isPressed()) {
-                        QLinearGradient grad(QPointF(9, 2), QPointF(9, 16));
-                        if (d && qGray(d->titleBarColor().rgb()) > 100)
-                        { // yellow isn't good with light backgrounds
-                            grad.setColorAt(0, isInactive ? inactiveCol
-                            : QColor(103, 149, 210));
-                            grad.setColorAt(1, isInactive ? inactiveCol
-                            : QColor(93, 135, 190));
-                        }
-                        else
-                        {
-                            grad.setColorAt(0, isInactive ? inactiveCol
-                            : QColor(135, 166, 220));
-                            grad.setColorAt(1, isInactive ? inactiveCol
-                            : QColor(122, 151, 200));
-                        }
-                        painter->setBrush(QBrush(grad));
-                        painter->setPen(Qt::NoPen);
-                        if (isChecked())
-                            painter->drawEllipse(QRectF(0, 0, 18, 18));
-                        else {
-                            painter->drawEllipse(QRectF(1, 1, 16, 16));
-                            if (backgroundColor.isValid())
-                            {
-                                painter->setPen(Qt::NoPen);
-                                painter->setBrush(backgroundColor);
-                                qreal r = static_cast<qreal>(7)
-                                + static_cast<qreal>(2) * m_animation->currentValue().toReal();
-                                QPointF c(static_cast<qreal>(9), static_cast<qreal>(9));
-                                painter->drawEllipse(c, r, r);
-                            }
-                        }
-                    }
-                    if (!macOSBtn || isPressed() || isHovered() || isChecked()) {
-                        painter->setPen(Qt::NoPen);
-                        if ((!macOSBtn  || isPressed()) && backgroundColor.isValid())
-                        {
-                            painter->setBrush(backgroundColor);
-                            painter->drawEllipse(QRectF(0, 0, 18, 18));
-                        }
-                        painter->setBrush(foregroundColor);
-
-                        if (macOSBtn)
-                            painter->drawEllipse(QRectF(6, 6, 6, 6));
-                        else {
-                            if (isChecked()) {
-
-                                // outer ring
-                                painter->drawEllipse(QRectF(3, 3, 12, 12));
-
-                                // center dot
-                                QColor backgroundColor(this->backgroundColor());
-                                if (!backgroundColor.isValid() && d) backgroundColor = d->titleBarColor();
-
-                                if (backgroundColor.isValid())
-                                {
-                                    painter->setBrush(backgroundColor);
-                                    painter->drawEllipse(QRectF(8, 8, 2, 2));
-                                }
-
-                            }
-                            else {
-                                painter->drawPolygon(QPolygonF()
-                                << QPointF(6.5, 8.5)
-                                << QPointF(12, 3)
-                                << QPointF(15, 6)
-                                << QPointF(9.5, 11.5));
-
-                                painter->setPen(pen);
-                                painter->drawLine(QPointF(5.5, 7.5), QPointF(10.5, 12.5));
-                                painter->drawLine(QPointF(12, 6), QPointF(4.5, 13.5));
-                            }
-                        }
-                    }
-                    break;
-                }
-
-                case DecorationButtonType::Shade:
-                {
-                    bool macOSBtn(!d || d->internalSettings()->macOSButtons());
-                    if (macOSBtn && !isPressed()) {
-                        QLinearGradient grad(QPointF(9, 2), QPointF(9, 16));
-                        if (d && qGray(d->titleBarColor().rgb()) > 100)
-                        { // yellow isn't good with light backgrounds
-                            grad.setColorAt(0, isInactive ? inactiveCol
-                            : QColor(103, 149, 210));
-                            grad.setColorAt(1, isInactive ? inactiveCol
-                            : QColor(93, 135, 190));
-                        }
-                        else
-                        {
-                            grad.setColorAt(0, isInactive ? inactiveCol
-                            : QColor(135, 166, 220));
-                            grad.setColorAt(1, isInactive ? inactiveCol
-                            : QColor(122, 151, 200));
-                        }
-                        painter->setBrush(QBrush(grad));
-                        painter->setPen(Qt::NoPen);
-                        if (isChecked())
-                            painter->drawEllipse(QRectF(0, 0, 18, 18));
-                        else {
-                            painter->drawEllipse(QRectF(1, 1, 16, 16));
-                            if (backgroundColor.isValid())
-                            {
-                                painter->setPen(Qt::NoPen);
-                                painter->setBrush(backgroundColor);
-                                qreal r = static_cast<qreal>(7)
-                                + static_cast<qreal>(2) * m_animation->currentValue().toReal();
-                                QPointF c(static_cast<qreal>(9), static_cast<qreal>(9));
-                                painter->drawEllipse(c, r, r);
-                            }
-                        }
-                    }
-                    if (!macOSBtn || isPressed() || isHovered() || isChecked()) {
-                        if ((!macOSBtn  || isPressed()) && backgroundColor.isValid())
-                        {
-                            painter->setPen(Qt::NoPen);
-                            painter->setBrush(backgroundColor);
-                            painter->drawEllipse(QRectF(0, 0, 18, 18));
-                        }
-                        painter->setPen(pen);
-                        painter->setBrush(Qt::NoBrush);
-
-                        painter->drawLine(5, 6, 13, 6);
-                        if (isChecked()) {
-                            painter->drawPolyline(QPolygonF()
-                            << QPointF(5, 9)
-                            << QPointF(9, 13)
-                            << QPointF(13, 9));
-
-                        }
-                        else {
-                            painter->drawPolyline(QPolygonF()
-                            << QPointF(5, 13)
-                            << QPointF(9, 9)
-                            << QPointF(13, 13));
-                        }
-                    }
-
-                    break;
-
-                }
-
-                case DecorationButtonType::KeepBelow:
-                {
-                    bool macOSBtn(!d || d->internalSettings()->macOSButtons() || isChecked());
-                    if (macOSBtn && !isPressed()) {
-                        QLinearGradient grad(QPointF(9, 2), QPointF(9, 16));
-                        if (d && qGray(d->titleBarColor().rgb()) > 100)
-                        { // yellow isn't good with light backgrounds
-                            grad.setColorAt(0, isInactive ? inactiveCol
-                            : QColor(103, 149, 210));
-                            grad.setColorAt(1, isInactive ? inactiveCol
-                            : QColor(93, 135, 190));
-                        }
-                        else
-                        {
-                            grad.setColorAt(0, isInactive ? inactiveCol
-                            : QColor(135, 166, 220));
-                            grad.setColorAt(1, isInactive ? inactiveCol
-                            : QColor(122, 151, 200));
-                        }
-                        painter->setBrush(QBrush(grad));
-                        painter->setPen(Qt::NoPen);
-                        if (isChecked())
-                            painter->drawEllipse(QRectF(0, 0, 18, 18));
-                        else {
-                            painter->drawEllipse(QRectF(1, 1, 16, 16));
-                            if (backgroundColor.isValid())
-                            {
-                                painter->setPen(Qt::NoPen);
-                                painter->setBrush(backgroundColor);
-                                qreal r = static_cast<qreal>(7)
-                                + static_cast<qreal>(2) * m_animation->currentValue().toReal();
-                                QPointF c(static_cast<qreal>(9), static_cast<qreal>(9));
-                                painter->drawEllipse(c, r, r);
-                            }
-                        }
-                    }
-                    if (!macOSBtn || isPressed() || isHovered() || isChecked()) {
-                        if ((!macOSBtn  || isPressed()) && backgroundColor.isValid())
-                        {
-                            painter->setPen(Qt::NoPen);
-                            painter->setBrush(backgroundColor);
-                            painter->drawEllipse(QRectF(0, 0, 18, 18));
-                        }
-                        painter->setPen(pen);
-                        painter->setBrush(Qt::NoBrush);
-
-                        if (macOSBtn) {
-                            painter->drawPolyline(QPolygonF()
-                            << QPointF(6, 6)
-                            << QPointF(9, 9)
-                            << QPointF(12, 6));
-
-                            painter->drawPolyline(QPolygonF()
-                            << QPointF(6, 10)
-                            << QPointF(9, 13)
-                            << QPointF(12, 10));
-                        }
-                        else {
-                            painter->drawPolyline(QPolygonF()
-                            << QPointF(5, 5)
-                            << QPointF(9, 9)
-                            << QPointF(13, 5));
-
-                            painter->drawPolyline(QPolygonF()
-                            << QPointF(5, 9)
-                            << QPointF(9, 13)
-                            << QPointF(13, 9));
-                        }
-                    }
-                    break;
-
-                }
-
-                case DecorationButtonType::KeepAbove:
-                {
-                    bool macOSBtn(!d || d->internalSettings()->macOSButtons());
-                    if (macOSBtn && !isPressed()) {
-                        QLinearGradient grad(QPointF(9, 2), QPointF(9, 16));
-                        if (d && qGray(d->titleBarColor().rgb()) > 100)
-                        { // yellow isn't good with light backgrounds
-                            grad.setColorAt(0, isInactive ? inactiveCol
-                            : QColor(103, 149, 210));
-                            grad.setColorAt(1, isInactive ? inactiveCol
-                            : QColor(93, 135, 190));
-                        }
-                        else
-                        {
-                            grad.setColorAt(0, isInactive ? inactiveCol
-                            : QColor(135, 166, 220));
-                            grad.setColorAt(1, isInactive ? inactiveCol
-                            : QColor(122, 151, 200));
-                        }
-                        painter->setBrush(QBrush(grad));
-                        painter->setPen(Qt::NoPen);
-                        if (isChecked())
-                            painter->drawEllipse(QRectF(0, 0, 18, 18));
-                        else {
-                            painter->drawEllipse(QRectF(1, 1, 16, 16));
-                            if (backgroundColor.isValid())
-                            {
-                                painter->setPen(Qt::NoPen);
-                                painter->setBrush(backgroundColor);
-                                qreal r = static_cast<qreal>(7)
-                                + static_cast<qreal>(2) * m_animation->currentValue().toReal();
-                                QPointF c(static_cast<qreal>(9), static_cast<qreal>(9));
-                                painter->drawEllipse(c, r, r);
-                            }
-                        }
-                    }
-                    if (!macOSBtn || isPressed() || isHovered() || isChecked()) {
-                        if ((!macOSBtn  || isPressed()) && backgroundColor.isValid())
-                        {
-                            painter->setPen(Qt::NoPen);
-                            painter->setBrush(backgroundColor);
-                            painter->drawEllipse(QRectF(0, 0, 18, 18));
-                        }
-                        painter->setPen(pen);
-                        painter->setBrush(Qt::NoBrush);
-
-                        if (macOSBtn) {
-                            painter->drawPolyline(QPolygonF()
-                            << QPointF(6, 8)
-                            << QPointF(9, 5)
-                            << QPointF(12, 8));
-
-                            painter->drawPolyline(QPolygonF()
-                            << QPointF(6, 12)
-                            << QPointF(9, 9)
-                            << QPointF(12, 12));
-                        }
-                        else {
-                            painter->drawPolyline(QPolygonF()
-                            << QPointF(5, 9)
-                            << QPointF(9, 5)
-                            << QPointF(13, 9));
-
-                            painter->drawPolyline(QPolygonF()
-                            << QPointF(5, 13)
-                            << QPointF(9, 9)
-                            << QPointF(13, 13));
-                        }
-                    }
-                    break;
-                }
-
-
-                case DecorationButtonType::ApplicationMenu:
-                {
-                    bool macOSBtn(!d || d->internalSettings()->macOSButtons());
-                    if (macOSBtn && !isPressed()) {
-                        QLinearGradient grad(QPointF(9, 2), QPointF(9, 16));
-                        if (d && qGray(d->titleBarColor().rgb()) > 100)
-                        { // yellow isn't good with light backgrounds
-                            grad.setColorAt(0, isInactive ? inactiveCol
-                            : QColor(230, 129, 67));
-                            grad.setColorAt(1, isInactive ? inactiveCol
-                            : QColor(210, 118, 61));
-                        }
-                        else
-                        {
-                            grad.setColorAt(0, isInactive ? inactiveCol
-                            : QColor(250, 145, 100));
-                            grad.setColorAt(1, isInactive ? inactiveCol
-                            : QColor(230, 131, 92));
-                        }
-                        painter->setBrush(QBrush(grad));
-                        painter->setPen(Qt::NoPen);
-                        painter->drawEllipse(QRectF(1, 1, 16, 16));
-                        if (backgroundColor.isValid())
-                        {
-                            painter->setPen(Qt::NoPen);
-                            painter->setBrush(backgroundColor);
-                            qreal r = static_cast<qreal>(7)
-                            + static_cast<qreal>(2) * m_animation->currentValue().toReal();
-                            QPointF c(static_cast<qreal>(9), static_cast<qreal>(9));
-                            painter->drawEllipse(c, r, r);
-                        }
-                    }
-                    if (!macOSBtn || isPressed() || isHovered()) {
-                        if ((!macOSBtn  || isPressed()) && backgroundColor.isValid())
-                        {
-                            painter->setPen(Qt::NoPen);
-                            painter->setBrush(backgroundColor);
-                            painter->drawEllipse(QRectF(0, 0, 18, 18));
-                        }
-                        painter->setPen(pen);
-                        painter->setBrush(Qt::NoBrush);
-
-                        if (macOSBtn) {
-                            painter->drawLine(QPointF(4.5, 6), QPointF(13.5, 6));
-                            painter->drawLine(QPointF(4.5, 9), QPointF(13.5, 9));
-                            painter->drawLine(QPointF(4.5, 12), QPointF(13.5, 12));
-                        }
-                        else {
-                            painter->drawLine(QPointF(3.5, 5), QPointF(14.5, 5));
-                            painter->drawLine(QPointF(3.5, 9), QPointF(14.5, 9));
-                            painter->drawLine(QPointF(3.5, 13), QPointF(14.5, 13));
-                        }
-                    }
-                    break;
-                }
-
-                case DecorationButtonType::ContextHelp:
-                {
-                    bool macOSBtn(!d || d->internalSettings()->macOSButtons());
-                    if (macOSBtn && !isPressed()) {
-                        QLinearGradient grad(QPointF(9, 2), QPointF(9, 16));
-                        if (d && qGray(d->titleBarColor().rgb()) > 100)
-                        { // yellow isn't good with light backgrounds
-                            grad.setColorAt(0, isInactive ? inactiveCol
-                            : QColor(103, 149, 210));
-                            grad.setColorAt(1, isInactive ? inactiveCol
-                            : QColor(93, 135, 190));
-                        }
-                        else
-                        {
-                            grad.setColorAt(0, isInactive ? inactiveCol
-                            : QColor(135, 166, 220));
-                            grad.setColorAt(1, isInactive ? inactiveCol
-                            : QColor(122, 151, 200));
-                        }
-                        painter->setBrush(QBrush(grad));
-                        painter->setPen(Qt::NoPen);
-                        painter->drawEllipse(QRectF(1, 1, 16, 16));
-                        if (backgroundColor.isValid())
-                        {
-                            painter->setPen(Qt::NoPen);
-                            painter->setBrush(backgroundColor);
-                            qreal r = static_cast<qreal>(7)
-                            + static_cast<qreal>(2) * m_animation->currentValue().toReal();
-                            QPointF c(static_cast<qreal>(9), static_cast<qreal>(9));
-                            painter->drawEllipse(c, r, r);
-                        }
-                    }
-                    if (!macOSBtn || isPressed() || isHovered()) {
-                        if ((!macOSBtn  || isPressed()) && backgroundColor.isValid())
-                        {
-                            painter->setPen(Qt::NoPen);
-                            painter->setBrush(backgroundColor);
-                            painter->drawEllipse(QRectF(0, 0, 18, 18));
-                        }
-                        painter->setPen(pen);
-                        painter->setBrush(Qt::NoBrush);
-
-                        QPainterPath path;
-                        path.moveTo(5, 6);
-                        path.arcTo(QRectF(5, 3.5, 8, 5), 180, -180);
-                        path.cubicTo(QPointF(12.5, 9.5), QPointF(9, 7.5), QPointF(9, 11.5));
-                        painter->drawPath(path);
-
-                        painter->drawPoint(9, 15);
-                    }
-
-                    break;
-                }
-
-                default: break;
+                if (centerColor.isValid())
+                {
+                    painter->setBrush(centerColor);
+                    painter->drawEllipse(QRectF(8, 8, 2, 2));
+                }
 
             }
-
+            else
+            {
+                ButtonGlyphs::fill(painter, ButtonGlyphs::PinHead, foregroundColor);
+                ButtonGlyphs::stroke(painter, ButtonGlyphs::PinNeedle, pen);
+            }
+            return;
         }
 
+        const ButtonGlyphs::Glyph glyph = macOSBtn
+            ? (isChecked() ? symbol->macOSCheckedGlyph : symbol->macOSGlyph)
+            : (isChecked() ? symbol->checkedGlyph : symbol->glyph);
+
+        if (macOSBtn && (symbol->flags & ButtonStyleEngine::FilledMacOS)) ButtonGlyphs::fill(painter, glyph, symbolColor);
+        else ButtonGlyphs::stroke(painter, glyph, pen);
+
     }
 
     //__________________________________________________________________
-    QColor Button::foregroundColor(const QColor& inactiveCol) const
+    QColor Button::foregroundColor(qreal progress) const
     {
-        auto d = qobject_cast<Decoration*>(decoration());
-        if (!d || d->internalSettings()->macOSButtons()) {
-            QColor col;
-            if (d && !d->window()->isActive()
-                && !isHovered() && !isPressed()
-                && m_animation->state() != QAbstractAnimation::Running)
-            {
-                int v = qGray(inactiveCol.rgb());
-                if (v > 127) v -= 127;
-                else v += 128;
-                col = QColor(v, v, v);
-            }
-            else
-            {
-                if (d && qGray(d->titleBarColor().rgb()) > 100)
-                    col = QColor(250, 250, 250);
-                else
-                    col = QColor(40, 40, 40);
-            }
-            return col;
-        }
-        else if (!d) {
-
-            return QColor();
+        auto d = m_decoration.data();
+        if (!d) return QColor(40, 40, 40);
 
-        } else if (isPressed()) {
+        const ButtonColors &colors(d->buttonColors());
+        const bool animated(m_animationRunning);
+        if (m_macOSButtons) {
 
-            return d->titleBarColor();
+            if (!d->window()->isActive() && !isHovered() && !isPressed() && !animated) return colors.inactiveSymbol;
+            else return colors.symbol;
 
-        /*} else if (type() == DecorationButtonType::Close && d->internalSettings()->outlineCloseButton()) {
+        } else if (isPressed()) {
 
-            return d->titleBarColor();*/
+            return colors.titleBar;
 
         } else if ((type() == DecorationButtonType::KeepBelow || type() == DecorationButtonType::KeepAbove) && isChecked()) {
 
-            return d->titleBarColor();
+            return colors.titleBar;
 
-        } else if (m_animation->state() == QAbstractAnimation::Running) {
+        } else if (animated) {
 
-            return KColorUtils::mix(d->fontColor(), d->titleBarColor(), m_opacity);
+            return KColorUtils::mix(colors.font, colors.titleBar, progress);
 
         } else if (isHovered()) {
 
-            return d->titleBarColor();
+            return colors.titleBar;
 
         } else {
 
-            return d->fontColor();
+            return colors.font;
 
         }
 
     }
 
     //__________________________________________________________________
-    QColor Button::backgroundColor() const
+    QColor Button::backgroundColor(qreal progress) const
     {
-        auto d = qobject_cast<Decoration*>(decoration());
+        auto d = m_decoration.data();
         if (!d) {
 
             return QColor();
 
         }
 
-        if (d->internalSettings()->macOSButtons()) {
-            if (isPressed()) {
-
-                QColor col;
-                if (type() == DecorationButtonType::Close)
-                {
-                    if (qGray(d->titleBarColor().rgb()) > 100)
-                        col = QColor(254, 73, 66);
-                    else
-                        col = QColor(240, 77, 80);
-                }
-                else if (type() == DecorationButtonType::Maximize)
-                {
-                    if (qGray(d->titleBarColor().rgb()) > 100)
-                        col = isChecked() ? QColor(0, 188, 154) : QColor(7, 201, 33);
-                    else
-                        col = isChecked() ? QColor(0, 188, 154) : QColor(101, 188, 34);
-                }
-                else if (type() == DecorationButtonType::Minimize)
-                {
-                    if (qGray(d->titleBarColor().rgb()) > 100)
-                        col = QColor(233, 160, 13);
-                    else
-                        col = QColor(227, 185, 59);
-                }
-                else if (type() == DecorationButtonType::ApplicationMenu) {
-                    if (qGray(d->titleBarColor().rgb()) > 100)
-                        col = QColor(220, 124, 64);
-                    else
-                        col = QColor(240, 139, 96);
-                }
-                else {
-                    if (qGray(d->titleBarColor().rgb()) > 100)
-                        col = QColor(83, 121, 170);
-                    else
-                        col = QColor(110, 136, 180);
-                }
-                if (col.isValid())
-                    return col;
-                else return KColorUtils::mix(d->titleBarColor(), d->fontColor(), 0.3);
-
-            } else if (m_animation->state() == QAbstractAnimation::Running) {
-
-                QColor col;
-                if (type() == DecorationButtonType::Close)
-                {
-                    if (qGray(d->titleBarColor().rgb()) > 100)
-                        col = QColor(254, 95, 87);
-                    else
-                        col = QColor(240, 96, 97);
-                }
-                else if (type() == DecorationButtonType::Maximize)
-                {
-                    if (qGray(d->titleBarColor().rgb()) > 100)
-                        col = isChecked() ? QColor(64, 188, 168) : QColor(39, 201, 63);
-                    else
-                        col = isChecked() ? QColor(64, 188, 168) : QColor(116, 188, 64);
-                }
-                else if (type() == DecorationButtonType::Minimize)
-                {
-                    if (qGray(d->titleBarColor().rgb()) > 100)
-                        col = QColor(233, 172, 41);
-                    else
-                        col = QColor(227, 191, 78);
-                }
-                else if (type() == DecorationButtonType::ApplicationMenu) {
-                    if (qGray(d->titleBarColor().rgb()) > 100)
-                        col = QColor(220, 124, 64);
-                    else
-                        col = QColor(240, 139, 96);
-                }
-                else {
-                    if (qGray(d->titleBarColor().rgb()) > 100)
-                        col = QColor(98, 141, 200);
-                    else
-                        col = QColor(128, 157, 210);
-                }
-                if (col.isValid())
-                    return col;
-                else {
-
-                    col = d->fontColor();
-                    col.setAlpha(col.alpha()*m_opacity);
-                    return col;
-
-                }
+        const ButtonColors &colors(d->buttonColors());
+        const bool animated(m_animationRunning);
+        if (m_macOSButtons) {
 
-            } else if (isHovered()) {
+            const int slot = ButtonColors::slot(type(), isChecked());
+            if (isPressed()) return colors.pressed[slot];
+            else if (animated || isHovered()) return colors.hovered[slot];
+            else return QColor();
 
-                QColor col;
-                if (type() == DecorationButtonType::Close)
-                {
-                    if (qGray(d->titleBarColor().rgb()) > 100)
-                        col = QColor(254, 95, 87);
-                    else
-                        col = QColor(240, 96, 97);
-                }
-                else if (type() == DecorationButtonType::Maximize)
-                {
-                    if (qGray(d->titleBarColor().rgb()) > 100)
-                        col = isChecked() ? QColor(64, 188, 168) : QColor(39, 201, 63);
-                    else
-                        col = isChecked() ? QColor(64, 188, 168) : QColor(116, 188, 64);
-                }
-                else if (type() == DecorationButtonType::Minimize)
-                {
-                    if (qGray(d->titleBarColor().rgb()) > 100)
-                        col = QColor(233, 172, 41);
-                    else
-                        col = QColor(227, 191, 78);
-                }
-                else if (type() == DecorationButtonType::ApplicationMenu) {
-                    if (qGray(d->titleBarColor().rgb()) > 100)
-                        col = QColor(220, 124, 64);
-                    else
-                        col = QColor(240, 139, 96);
-                }
-                else {
-                    if (qGray(d->titleBarColor().rgb()) > 100)
-                        col = QColor(98, 141, 200);
-                    else
-                        col = QColor(128, 157, 210);
-                }
-                if (col.isValid())
-                    return col;
-                else return d->fontColor();
+        } else if (isPressed()) {
 
-            } else {
+            return type() == DecorationButtonType::Close ? colors.closePressed : colors.flatPressed;
 
-                return QColor();
+        } else if ((type() == DecorationButtonType::KeepBelow || type() == DecorationButtonType::KeepAbove) && isChecked()) {
 
-            }
-        }
-        else {
-            auto c = d->window();
-            if (isPressed()) {
+            return colors.flatHovered;
 
-                if (type() == DecorationButtonType::Close) return c->color(ColorGroup::Warning, ColorRole::Foreground);
-                else
-                {
-                    QColor col;
-                    if (qGray(d->titleBarColor().rgb()) > 100)
-                        col = QColor(0, 0, 0, 190);
-                    else
-                        col = QColor(255, 255, 255, 210);
-                    return col;
-                }
+        } else if (animated) {
 
-            } else if ((type() == DecorationButtonType::KeepBelow || type() == DecorationButtonType::KeepAbove) && isChecked()) {
+            QColor col(type() == DecorationButtonType::Close ? colors.closeHovered : colors.flatHovered);
+            col.setAlpha(col.alpha()*progress);
+            return col;
 
-                    QColor col;
-                    if (qGray(d->titleBarColor().rgb()) > 100)
-                        col = QColor(0, 0, 0, 165);
-                    else
-                        col = QColor(255, 255, 255, 180);
-                    return col;
+        } else if (isHovered()) {
 
-            } else if (m_animation->state() == QAbstractAnimation::Running) {
+            return type() == DecorationButtonType::Close ? colors.closeHovered : colors.flatHovered;
 
-                if (type() == DecorationButtonType::Close)
-                {
+        } else {
 
-                    QColor color(c->color(ColorGroup::Warning, ColorRole::Foreground).lighter());
-                    color.setAlpha(color.alpha()*m_opacity);
-                    return color;
+            return QColor();
 
-                } else {
+        }
 
-                    QColor col;
-                    if (qGray(d->titleBarColor().rgb()) > 100)
-                        col = QColor(0, 0, 0, 165);
-                    else
-                        col = QColor(255, 255, 255, 180);
-                    col.setAlpha(col.alpha()*m_opacity);
-                    return col;
+    }
 
-                }
+    //________________________________________________________________
+    void Button::reconfigure()
+    {
 
-            } else if (isHovered()) {
+        auto d = m_decoration.data();
+        if (!d) return;
 
-                if (type() == DecorationButtonType::Close) return c->color(ColorGroup::Warning, ColorRole::Foreground).lighter();
-                else
-                {
+        // animation
+        const SettingsSnapshot &settings(d->settingsSnapshot());
+        m_animationDuration = settings.animationsDuration;
+        m_animationFrames = settings.animationFrames;
+        setPreferredSize(QSizeF(d->buttonSize(), d->buttonSize()));
+
+        // style specific renderer, resolved once rather than on every paint
+        m_buttonStyle = settings.buttonStyle;
+        m_macOSButtons = settings.macOSButtons;
+        switch (m_buttonStyle)
+        {
+            case 0: m_renderer = &Button::drawIcon; break;
+            case 1:
+            case 2: m_renderer = &Button::drawIconMacOS; break;
+            case 3: m_renderer = &Button::drawIconPlasma; break;
+            default: m_renderer = nullptr; break;
+        }
 
-                    QColor col;
-                    if (qGray(d->titleBarColor().rgb()) > 100)
-                        col = QColor(0, 0, 0, 165);
-                    else
-                        col = QColor(255, 255, 255, 180);
-                    return col;
+    }
 
-                }
+    //__________________________________________________________________
+    void Button::updateIcon()
+    {
 
-            } else {
+        // some applications animate their icon, do not follow faster than this
+        static constexpr int iconUpdateInterval = 250;
 
-                return QColor();
+        if (m_iconTimer && m_iconTimer->isActive())
+        {
+            m_iconUpdatePending = true;
+            return;
+        }
 
-            }
+        if (!m_iconTimer)
+        {
+            m_iconTimer = new QTimer(this);
+            m_iconTimer->setSingleShot(true);
+            connect(m_iconTimer, &QTimer::timeout, this, [this]() {
+                if (!m_iconUpdatePending) return;
+                m_iconUpdatePending = false;
+                updateIcon();
+            });
         }
 
+        m_iconPixmap = QPixmap();
+        update();
+        m_iconTimer->start(iconUpdateInterval);
+
     }
 
-    //________________________________________________________________
-    void Button::reconfigure()
+    //__________________________________________________________________
+    void Button::updateAnimationState(bool hovered)
     {
 
-        // animation
-        if (auto d = qobject_cast<Decoration*>(decoration()))
-        {
-            m_animation->setDuration(d->internalSettings()->animationsDuration());
-            setPreferredSize(QSizeF(d->buttonSize(), d->buttonSize()));
-        }
+        auto d = m_decoration.data();
+        if (!(d && d->settingsSnapshot().animationsEnabled)) return;
+
+        // a reversed animation continues from its current position
+        m_animationForward = hovered;
+        if (m_animationRunning) return;
+
+        m_animationRunning = true;
+        ButtonAnimator::self().start(this);
 
     }
 
     //__________________________________________________________________
-    void Button::updateAnimationState(bool hovered)
+    bool Button::advanceAnimation(qint64 elapsed)
     {
 
-        auto d = qobject_cast<Decoration*>(decoration());
-        if (!(d && d->internalSettings()->animationsEnabled())) return;
+        static const QEasingCurve easingCurve(QEasingCurve::InOutQuad);
+
+        const qreal step = m_animationDuration > 0 ? qreal(elapsed)/m_animationDuration : 1.0;
+        m_animationTime = qBound<qreal>(0, m_animationTime + (m_animationForward ? step : -step), 1);
+        m_opacity = easingCurve.valueForProgress(m_animationTime);
 
-        QAbstractAnimation::Direction dir = hovered ? QAbstractAnimation::Forward : QAbstractAnimation::Backward;
-        if (m_animation->state() == QAbstractAnimation::Running && m_animation->direction() != dir)
-            m_animation->stop();
-        m_animation->setDirection(dir);
-        if (m_animation->state() != QAbstractAnimation::Running) m_animation->start();
+        m_animationRunning = m_animationForward ? m_animationTime < 1 : m_animationTime > 0;
+        return m_animationRunning;
 
     }
 
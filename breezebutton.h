@@ -21,13 +21,18 @@
 
 #pragma once
 
+#include "breezebuttonatlas.h"
 #include "breezedecoration.h"
 #include <KDecoration3/DecorationButton>
 
 #include <QHash>
 #include <QImage>
+#include <QPixmap>
+#include <QPointer>
 
-class QVariantAnimation;
+#include <optional>
+
+class QTimer;
 
 namespace Breeze
 {
@@ -42,7 +47,7 @@ namespace Breeze
         explicit Button(QObject *parent, const QVariantList &args);
 
         //* destructor
-        virtual ~Button() = default;
+        ~Button() override;
 
         //* button creation
         static Button *create(KDecoration3::DecorationButtonType type, KDecoration3::Decoration *decoration, QObject *parent);
@@ -82,6 +87,9 @@ namespace Breeze
             return m_opacity;
         }
 
+        //* advance animation by given time, in ms, driven by ButtonAnimator. Returns false once finished
+        bool advanceAnimation(qint64 elapsed);
+
         //@}
 
         void setPreferredSize(const QSizeF &size)
@@ -94,43 +102,64 @@ namespace Breeze
             return m_preferredSize;
         }
 
-        private Q_SLOTS:
-
-        //* apply configuration changes
+        //* apply configuration changes, called by the decoration when its settings change
         void reconfigure();
 
+        private Q_SLOTS:
+
         //* animation state
         void updateAnimationState(bool);
 
+        //* window icon changed
+        void updateIcon();
+
         private:
 
         //* private constructor
         explicit Button(KDecoration3::DecorationButtonType type, Decoration *decoration, QObject *parent = nullptr);
 
+        //* draw button according to the configured style, at given hover animation progress
+        void drawButton(QPainter *, qreal progress) const;
+
         //* draw button icon
-        void drawIcon(QPainter *) const;
-        void drawIconPlasma( QPainter *) const;
-        void drawIconAqua( QPainter *) const;
-        void drawIconMacSierra( QPainter *) const;
-        void drawIconMacDarkAurorae( QPainter *) const;
-        void drawIconSBEsierra( QPainter *) const;
-        void drawIconSBEdarkAurorae( QPainter *) const;
-        void drawIconSierraColorSymbols( QPainter *) const;
-        void drawIconDarkAuroraeColorSymbols( QPainter *) const;
-        void drawIconSierraMonochromeSymbols( QPainter *) const;
-        void drawIconDarkAuroraeMonochromeSymbols( QPainter *) const;
+        void drawIcon(QPainter *, qreal progress) const;
+        void drawIconPlasma( QPainter *, qreal progress) const;
+        void drawIconMacOS(QPainter *, qreal progress) const;
+
+        //* draw the colored disc of given button style, as described by ButtonStyleEngine
+        void drawDisc(QPainter *, int style, const QColor &backgroundColor, bool isInactive, const QColor &inactiveCol, qreal progress) const;
 
         //*@name colors
         //@{
         QColor fontColor() const;
-        QColor foregroundColor(const QColor& inactiveCol) const;
-        QColor backgroundColor() const;
+        QColor foregroundColor(qreal progress) const;
+        QColor backgroundColor(qreal progress) const;
         QColor mixColors(const QColor&, const QColor&, qreal) const;
         QColor autoColor( const bool, const bool, const bool, const QColor, const QColor ) const;
         //@}
 
-        //* active state change animation
-        QVariantAnimation *m_animation;
+        //* decoration, typed
+        QPointer<Decoration> m_decoration;
+
+        //*@name style, resolved on reconfiguration
+        //@{
+        using Renderer = void (Button::*)(QPainter *, qreal progress) const;
+        Renderer m_renderer = nullptr;
+        int m_buttonStyle = 0;
+        bool m_macOSButtons = false;
+        //@}
+
+        //* appearance currently shown, referenced in the shared button atlas
+        std::optional<ButtonAtlas::Key> m_appearance;
+
+        //*@name hover animation, see ButtonAnimator
+        //@{
+        int m_animationDuration = 0;
+        int m_animationFrames = 0;
+        qreal m_animationTime = 0;
+        bool m_animationForward = true;
+        bool m_animationRunning = false;
+        //@}
 
         //* padding (for rendering)
         QMargins m_padding;
@@ -138,8 +167,18 @@ namespace Breeze
         //* implicit size
         QSizeF m_preferredSize;
 
-        //* active state change opacity
+        //* active state change opacity, eased animation progress
         qreal m_opacity = 0;
+
+        //*@name cached window icon, for the menu button
+        //@{
+        QPixmap m_iconPixmap;
+        qint64 m_iconCacheKey = 0;
+        QSize m_iconSize;
+        qreal m_iconDevicePixelRatio = 0;
+        QTimer *m_iconTimer = nullptr;
+        bool m_iconUpdatePending = false;
+        //@}
     };
 
 } // namespace
@@ -0,0 +1,103 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License or (at your option) version 3 or any later version
+ * accepted by the membership of KDE e.V. (or its successor approved
+ * by the membership of KDE e.V.), which shall act as a proxy
+ * defined in Section 14 of version 3 of the license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "breezebuttonanimator.h"
+#include "breezebutton.h"
+
+#include <KDecoration3/Decoration>
+
+#include <QCoreApplication>
+#include <QHash>
+
+#include <limits>
+
+namespace Breeze
+{
+
+    //__________________________________________________________________
+    ButtonAnimator &ButtonAnimator::self()
+    {
+        static ButtonAnimator s_animator;
+        return s_animator;
+    }
+
+    //__________________________________________________________________
+    ButtonAnimator::ButtonAnimator() = default;
+
+    //__________________________________________________________________
+    void ButtonAnimator::start(Button *button)
+    {
+        if (m_buttons.contains(button)) return;
+
+        if (!m_timer)
+        {
+            auto application = QCoreApplication::instance();
+            if (!application)
+            {
+                // nothing can drive the animation, finish it right away
+                button->advanceAnimation(std::numeric_limits<int>::max());
+                if (auto d = button->decoration().data()) d->update(button->geometry());
+                return;
+            }
+
+            m_timer = new QTimer(application);
+            m_timer->setInterval(FrameInterval);
+            m_timer->setTimerType(Qt::PreciseTimer);
+            QObject::connect(m_timer, &QTimer::timeout, m_timer, [this]() { tick(); });
+        }
+
+        m_buttons.append(button);
+        if (!m_timer->isActive())
+        {
+            m_clock.start();
+            m_timer->start();
+        }
+    }
+
+    //__________________________________________________________________
+    void ButtonAnimator::stop(Button *button)
+    {
+        m_buttons.removeOne(button);
+        if (m_buttons.isEmpty() && m_timer) m_timer->stop();
+    }
+
+    //__________________________________________________________________
+    void ButtonAnimator::tick()
+    {
+        const qint64 elapsed = m_clock.restart();
+
+        // collect the repainted area of each decoration
+        QHash<KDecoration3::Decoration*, QRectF> dirtyRects;
+        for (int i = 0; i < m_buttons.size();)
+        {
+            Button *button = m_buttons.at(i);
+            const bool running = button->advanceAnimation(elapsed);
+            if (auto d = button->decoration().data()) dirtyRects[d] |= button->geometry();
+
+            if (running) ++i;
+            else m_buttons.removeAt(i);
+        }
+
+        for (auto it = dirtyRects.constBegin(); it != dirtyRects.constEnd(); ++it)
+        { it.key()->update(it.value()); }
+
+        if (m_buttons.isEmpty()) m_timer->stop();
+    }
+
+}
@@ -0,0 +1,66 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License or (at your option) version 3 or any later version
+ * accepted by the membership of KDE e.V. (or its successor approved
+ * by the membership of KDE e.V.), which shall act as a proxy
+ * defined in Section 14 of version 3 of the license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QPointer>
+#include <QTimer>
+#include <QVector>
+
+namespace Breeze
+{
+
+    class Button;
+
+    //* process wide clock driving the hover animations of all buttons
+    class ButtonAnimator
+    {
+
+        public:
+
+        //* singleton
+        static ButtonAnimator &self();
+
+        //* start driving given button, until its animation is finished. Without application, the animation is finished at once
+        void start(Button *button);
+
+        //* stop driving given button, e.g. on destruction
+        void stop(Button *button);
+
+        private:
+
+        //* constructor
+        ButtonAnimator();
+
+        //* advance all running animations and repaint them, once per decoration
+        void tick();
+
+        //* tick interval, in ms
+        static constexpr int FrameInterval = 16;
+
+        //* created on first use, and owned by the application so that it is gone before static destruction
+        QPointer<QTimer> m_timer;
+
+        QElapsedTimer m_clock;
+        QVector<Button*> m_buttons;
+
+    };
+
+}
@@ -0,0 +1,131 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License or (at your option) version 3 or any later version
+ * accepted by the membership of KDE e.V. (or its successor approved
+ * by the membership of KDE e.V.), which shall act as a proxy
+ * defined in Section 14 of version 3 of the license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "breezebuttonatlas.h"
+#include "breezeinstrumentation.h"
+
+#include <QPainter>
+#include <QtMath>
+
+namespace Breeze
+{
+
+    //__________________________________________________________________
+    size_t qHash(const ButtonAtlas::Key &key, size_t seed)
+    {
+        return qHashMulti(seed, key.style, key.type, key.state, key.progress,
+                          key.size.width(), key.size.height(), key.devicePixelRatio, key.phase.x(), key.phase.y(),
+                          key.titleBarColor, key.fontColor, key.warningColor);
+    }
+
+    //__________________________________________________________________
+    ButtonAtlas &ButtonAtlas::self()
+    {
+        static ButtonAtlas s_atlas;
+        return s_atlas;
+    }
+
+    //__________________________________________________________________
+    QImage ButtonAtlas::image(const Key &key, const Renderer &renderer)
+    { return entry(key, renderer).image; }
+
+    //__________________________________________________________________
+    QImage ButtonAtlas::acquire(const Key &key, const Renderer &renderer)
+    {
+        Entry &entry(this->entry(key, renderer));
+        ++entry.refCount;
+        return entry.image;
+    }
+
+    //__________________________________________________________________
+    void ButtonAtlas::release(const Key &key)
+    {
+        auto it = m_images.find(key);
+        if (it == m_images.end() || it->refCount == 0) return;
+
+        if (--it->refCount == 0 && m_draining)
+        {
+            updateBytes(-it->image.sizeInBytes());
+            m_images.erase(it);
+        }
+    }
+
+    //__________________________________________________________________
+    void ButtonAtlas::clear()
+    {
+        qint64 delta = 0;
+        for (auto it = m_images.begin(); it != m_images.end();)
+        {
+            if (it->refCount > 0) ++it;
+            else
+            {
+                delta -= it->image.sizeInBytes();
+                it = m_images.erase(it);
+            }
+        }
+
+        updateBytes(delta);
+    }
+
+    //__________________________________________________________________
+    void ButtonAtlas::drain()
+    {
+        clear();
+        m_draining = true;
+    }
+
+    //__________________________________________________________________
+    ButtonAtlas::Entry &ButtonAtlas::entry(const Key &key, const Renderer &renderer)
+    {
+        auto it = m_images.find(key);
+        if (it != m_images.end())
+        {
+            Instrumentation::count(Instrumentation::ButtonImageHits);
+            return it.value();
+        }
+
+        Instrumentation::count(Instrumentation::ButtonImageMisses);
+        if (m_images.size() >= MaxImages) clear();
+
+        // images are in use again
+        m_draining = false;
+
+        QImage image(qCeil(key.size.width()*key.devicePixelRatio + key.phase.x()),
+                     qCeil(key.size.height()*key.devicePixelRatio + key.phase.y()),
+                     QImage::Format_ARGB32_Premultiplied);
+        image.setDevicePixelRatio(key.devicePixelRatio);
+        image.fill(Qt::transparent);
+
+        // the button keeps its position within the device pixel
+        QPainter painter(&image);
+        painter.translate(key.phase/key.devicePixelRatio);
+        renderer(&painter);
+        painter.end();
+
+        updateBytes(image.sizeInBytes());
+        return m_images.insert(key, Entry{ image, 0 }).value();
+    }
+
+    //__________________________________________________________________
+    void ButtonAtlas::updateBytes(qint64 delta)
+    {
+        m_bytes += delta;
+        Instrumentation::set(Instrumentation::ButtonImageBytes, m_bytes);
+    }
+
+}
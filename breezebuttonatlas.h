@@ -0,0 +1,133 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License or (at your option) version 3 or any later version
+ * accepted by the membership of KDE e.V. (or its successor approved
+ * by the membership of KDE e.V.), which shall act as a proxy
+ * defined in Section 14 of version 3 of the license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QColor>
+#include <QHash>
+#include <QImage>
+#include <QPointF>
+#include <QSizeF>
+
+#include <functional>
+
+class QPainter;
+
+namespace Breeze
+{
+
+    //* process wide cache of rendered button images, shared by all decorations
+    /**
+    buttons keep a reference to the image they currently show, so that images in use are
+    never evicted and identical buttons of all windows share a single image
+    */
+    class ButtonAtlas
+    {
+
+        public:
+
+        //* button state flags
+        enum State
+        {
+            Checked = 1<<0,
+            Hovered = 1<<1,
+            Pressed = 1<<2,
+            Active = 1<<3,
+            Animated = 1<<4,
+            MacOSButtons = 1<<5
+        };
+
+        //* everything a button image depends on
+        struct Key
+        {
+            int style = 0;
+            int type = 0;
+            int state = 0;
+            qreal progress = 0;
+            QSizeF size;
+            qreal devicePixelRatio = 1;
+
+            //* position of the button within its device pixel, the image being blitted to whole device pixels
+            QPointF phase;
+            QRgb titleBarColor = 0;
+            QRgb fontColor = 0;
+            QRgb warningColor = 0;
+
+            bool operator==(const Key &) const = default;
+        };
+
+        //* renders a button into a painter whose origin is the top left corner of the button
+        using Renderer = std::function<void(QPainter *)>;
+
+        //* singleton
+        static ButtonAtlas &self();
+
+        //* image for given key, rendered on first use
+        QImage image(const Key &key, const Renderer &renderer);
+
+        //* image for given key, rendered on first use. The image is kept until released
+        QImage acquire(const Key &key, const Renderer &renderer);
+
+        //* release image acquired for given key
+        void release(const Key &key);
+
+        //* true if the image for given key is already rendered
+        bool contains(const Key &key) const
+        { return m_images.contains(key); }
+
+        //* drop all images not in use, e.g. on reconfiguration
+        void clear();
+
+        //* drop all images not in use, and the images in use once released, until a new image is rendered
+        /**
+        used when the last decoration goes away, before its buttons release their images
+        */
+        void drain();
+
+        private:
+
+        //* cached image
+        struct Entry
+        {
+            QImage image;
+            int refCount = 0;
+        };
+
+        //* entry for given key, rendered on first use
+        Entry &entry(const Key &key, const Renderer &renderer);
+
+        //* update memory instrumentation
+        void updateBytes(qint64 delta);
+
+        //* maximum number of cached images, unused images are dropped when exceeded
+        static constexpr int MaxImages = 512;
+
+        QHash<Key, Entry> m_images;
+
+        //* memory used by all images
+        qint64 m_bytes = 0;
+
+        //* true if released images are dropped, see drain()
+        bool m_draining = false;
+
+    };
+
+    //* hash
+    size_t qHash(const ButtonAtlas::Key &key, size_t seed = 0);
+
+}
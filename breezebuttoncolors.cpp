@@ -0,0 +1,89 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License or (at your option) version 3 or any later version
+ * accepted by the membership of KDE e.V. (or its successor approved
+ * by the membership of KDE e.V.), which shall act as a proxy
+ * defined in Section 14 of version 3 of the license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "breezebuttoncolors.h"
+
+namespace Breeze
+{
+
+    using KDecoration3::DecorationButtonType;
+
+    //__________________________________________________________________
+    ButtonColors::Slot ButtonColors::slot(DecorationButtonType type, bool checked)
+    {
+        switch (type)
+        {
+            case DecorationButtonType::Close: return Close;
+            case DecorationButtonType::Maximize: return checked ? MaximizeChecked : Maximize;
+            case DecorationButtonType::Minimize: return Minimize;
+            case DecorationButtonType::ApplicationMenu: return ApplicationMenu;
+            default: return Other;
+        }
+    }
+
+    //__________________________________________________________________
+    void ButtonColors::update(const QColor &titleBarColor, const QColor &fontColor, const QColor &warningColor)
+    {
+
+        titleBar = titleBarColor;
+        font = fontColor;
+        titleBarGray = qGray(titleBarColor.rgb());
+        const bool light = titleBarGray > 100;
+
+        // inactive discs and their symbols
+        int gray = titleBarGray;
+        if (gray <= 200)
+        {
+            gray += 55;
+            gray = qMax(gray, 115);
+        }
+        else gray -= 45;
+        inactive = QColor(gray, gray, gray);
+
+        gray = qGray(inactive.rgb());
+        if (gray > 127) gray -= 127;
+        else gray += 128;
+        inactiveSymbol = QColor(gray, gray, gray);
+
+        symbol = light ? QColor(250, 250, 250) : QColor(40, 40, 40);
+
+        // macOS like buttons
+        pressed[Close] = light ? QColor(254, 73, 66) : QColor(240, 77, 80);
+        pressed[Maximize] = light ? QColor(7, 201, 33) : QColor(101, 188, 34);
+        pressed[MaximizeChecked] = QColor(0, 188, 154);
+        pressed[Minimize] = light ? QColor(233, 160, 13) : QColor(227, 185, 59);
+        pressed[ApplicationMenu] = light ? QColor(220, 124, 64) : QColor(240, 139, 96);
+        pressed[Other] = light ? QColor(83, 121, 170) : QColor(110, 136, 180);
+
+        hovered[Close] = light ? QColor(254, 95, 87) : QColor(240, 96, 97);
+        hovered[Maximize] = light ? QColor(39, 201, 63) : QColor(116, 188, 64);
+        hovered[MaximizeChecked] = QColor(64, 188, 168);
+        hovered[Minimize] = light ? QColor(233, 172, 41) : QColor(227, 191, 78);
+        hovered[ApplicationMenu] = light ? QColor(220, 124, 64) : QColor(240, 139, 96);
+        hovered[Other] = light ? QColor(98, 141, 200) : QColor(128, 157, 210);
+
+        // flat buttons
+        flatPressed = light ? QColor(0, 0, 0, 190) : QColor(255, 255, 255, 210);
+        flatHovered = light ? QColor(0, 0, 0, 165) : QColor(255, 255, 255, 180);
+        closePressed = warningColor;
+        closeHovered = warningColor.lighter();
+
+    }
+
+}
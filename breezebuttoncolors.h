@@ -0,0 +1,86 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License or (at your option) version 3 or any later version
+ * accepted by the membership of KDE e.V. (or its successor approved
+ * by the membership of KDE e.V.), which shall act as a proxy
+ * defined in Section 14 of version 3 of the license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+#include <KDecoration3/DecorationButton>
+
+#include <QColor>
+
+namespace Breeze
+{
+
+    //* button colors resolved for one title bar palette
+    class ButtonColors
+    {
+
+        public:
+
+        //* color slots of the macOS like buttons
+        enum Slot
+        {
+            Close,
+            Maximize,
+            MaximizeChecked,
+            Minimize,
+            ApplicationMenu,
+            Other,
+            SlotCount
+        };
+
+        //* slot of given button
+        static Slot slot(KDecoration3::DecorationButtonType type, bool checked);
+
+        //* resolve all colors from the title bar palette
+        void update(const QColor &titleBarColor, const QColor &fontColor, const QColor &warningColor);
+
+        //*@name palette
+        //@{
+        QColor titleBar;
+        QColor font;
+        int titleBarGray = 0;
+        //@}
+
+        //*@name macOS like buttons
+        //@{
+
+        //* disc color of inactive windows
+        QColor inactive;
+
+        //* symbol color of inactive windows
+        QColor inactiveSymbol;
+
+        //* symbol color
+        QColor symbol;
+
+        QColor pressed[SlotCount];
+        QColor hovered[SlotCount];
+        //@}
+
+        //*@name flat buttons
+        //@{
+        QColor flatPressed;
+        QColor flatHovered;
+        QColor closePressed;
+        QColor closeHovered;
+        //@}
+
+    };
+
+}
@@ -0,0 +1,201 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License or (at your option) version 3 or any later version
+ * accepted by the membership of KDE e.V. (or its successor approved
+ * by the membership of KDE e.V.), which shall act as a proxy
+ * defined in Section 14 of version 3 of the license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "breezebuttonglyphs.h"
+
+#include <QHash>
+#include <QPainter>
+#include <QPainterPathStroker>
+#include <QPen>
+
+#include <array>
+
+namespace Breeze
+{
+
+    namespace ButtonGlyphs
+    {
+
+        namespace
+        {
+
+            struct Point
+            {
+                qreal x;
+                qreal y;
+            };
+
+            //* polyline, or round dot if it has a single point
+            struct Line
+            {
+                int count;
+                bool closed;
+                Point points[4];
+            };
+
+            struct GlyphData
+            {
+                int count;
+                Line lines[3];
+            };
+
+            // indexed by Glyph
+            constexpr GlyphData s_glyphs[GlyphCount] =
+            {
+                // Close
+                { 2, { { 2, false, { { 5, 5 }, { 13, 13 } } }, { 2, false, { { 5, 13 }, { 13, 5 } } } } },
+                // CloseSmall
+                { 2, { { 2, false, { { 6, 6 }, { 12, 12 } } }, { 2, false, { { 6, 12 }, { 12, 6 } } } } },
+                // Maximize
+                { 2, { { 3, false, { { 5, 8 }, { 5, 13 }, { 10, 13 } } }, { 3, false, { { 8, 5 }, { 13, 5 }, { 13, 10 } } } } },
+                // Restore
+                { 2, { { 3, false, { { 5, 8 }, { 5, 13 }, { 10, 13 } } }, { 4, true, { { 8, 5 }, { 13, 5 }, { 13, 10 }, { 8, 10 } } } } },
+                // Minimize
+                { 1, { { 2, false, { { 4, 9 }, { 14, 9 } } } } },
+                // MinimizeSmall
+                { 1, { { 2, false, { { 5, 9 }, { 13, 9 } } } } },
+                // Shade
+                { 2, { { 2, false, { { 5, 6 }, { 13, 6 } } }, { 3, false, { { 5, 13 }, { 9, 9 }, { 13, 13 } } } } },
+                // Unshade
+                { 2, { { 2, false, { { 5, 6 }, { 13, 6 } } }, { 3, false, { { 5, 9 }, { 9, 13 }, { 13, 9 } } } } },
+                // KeepBelow
+                { 2, { { 3, false, { { 5, 5 }, { 9, 9 }, { 13, 5 } } }, { 3, false, { { 5, 9 }, { 9, 13 }, { 13, 9 } } } } },
+                // KeepBelowSmall
+                { 2, { { 3, false, { { 6, 6 }, { 9, 9 }, { 12, 6 } } }, { 3, false, { { 6, 10 }, { 9, 13 }, { 12, 10 } } } } },
+                // KeepAbove
+                { 2, { { 3, false, { { 5, 9 }, { 9, 5 }, { 13, 9 } } }, { 3, false, { { 5, 13 }, { 9, 9 }, { 13, 13 } } } } },
+                // KeepAboveSmall
+                { 2, { { 3, false, { { 6, 8 }, { 9, 5 }, { 12, 8 } } }, { 3, false, { { 6, 12 }, { 9, 9 }, { 12, 12 } } } } },
+                // ApplicationMenu
+                { 3, { { 2, false, { { 3.5, 5 }, { 14.5, 5 } } }, { 2, false, { { 3.5, 9 }, { 14.5, 9 } } }, { 2, false, { { 3.5, 13 }, { 14.5, 13 } } } } },
+                // ApplicationMenuSmall
+                { 3, { { 2, false, { { 4.5, 6 }, { 13.5, 6 } } }, { 2, false, { { 4.5, 9 }, { 13.5, 9 } } }, { 2, false, { { 4.5, 12 }, { 13.5, 12 } } } } },
+                // ContextHelp, the curved part is added in centerLine
+                { 1, { { 1, false, { { 9, 15 } } } } },
+                // PinNeedle
+                { 2, { { 2, false, { { 5.5, 7.5 }, { 10.5, 12.5 } } }, { 2, false, { { 12, 6 }, { 4.5, 13.5 } } } } },
+                // PinHead
+                { 1, { { 4, true, { { 6.5, 8.5 }, { 12, 3 }, { 15, 6 }, { 9.5, 11.5 } } } } },
+                // MaximizeTriangles
+                { 2, { { 3, true, { { 5, 13 }, { 11, 13 }, { 5, 7 } } }, { 3, true, { { 13, 5 }, { 7, 5 }, { 13, 11 } } } } },
+                // RestoreTriangles
+                { 2, { { 3, true, { { 8.5, 9.5 }, { 2.5, 9.5 }, { 8.5, 15.5 } } }, { 3, true, { { 9.5, 8.5 }, { 15.5, 8.5 }, { 9.5, 2.5 } } } } }
+            };
+
+            //* polylines of a glyph, without its dots
+            QPainterPath centerLine(Glyph glyph)
+            {
+                QPainterPath path;
+                if (glyph == ContextHelp)
+                {
+                    path.moveTo(5, 6);
+                    path.arcTo(QRectF(5, 3.5, 8, 5), 180, -180);
+                    path.cubicTo(QPointF(12.5, 9.5), QPointF(9, 7.5), QPointF(9, 11.5));
+                }
+
+                const GlyphData &data(s_glyphs[glyph]);
+                for (int i = 0; i < data.count; ++i)
+                {
+                    const Line &line(data.lines[i]);
+                    if (line.count < 2) continue;
+
+                    path.moveTo(line.points[0].x, line.points[0].y);
+                    for (int j = 1; j < line.count; ++j)
+                    { path.lineTo(line.points[j].x, line.points[j].y); }
+                    if (line.closed) path.closeSubpath();
+                }
+
+                return path;
+            }
+
+            //* stroked outline cache key
+            struct OutlineKey
+            {
+                int glyph = 0;
+
+                //* pen width, in 1/64th of the normalized button space
+                int penWidth = 0;
+
+                bool operator==(const OutlineKey &) const = default;
+            };
+
+            size_t qHash(const OutlineKey &key, size_t seed = 0)
+            { return qHashMulti(seed, key.glyph, key.penWidth); }
+
+            //* maximum number of cached outlines, the cache is reset when exceeded
+            constexpr int MaxOutlines = 256;
+
+        }
+
+        //__________________________________________________________________
+        QPainterPath outline(Glyph glyph, qreal penWidth)
+        {
+            static QHash<OutlineKey, QPainterPath> s_outlines;
+
+            // pen widths vary with the button size, quantized so that similar sizes share outlines
+            const OutlineKey key{ glyph, qRound(penWidth*64) };
+            auto it = s_outlines.constFind(key);
+            if (it != s_outlines.constEnd()) return it.value();
+
+            if (s_outlines.size() >= MaxOutlines) s_outlines.clear();
+            penWidth = key.penWidth/64.0;
+
+            QPainterPathStroker stroker;
+            stroker.setWidth(penWidth);
+            stroker.setCapStyle(Qt::RoundCap);
+            stroker.setJoinStyle(Qt::MiterJoin);
+            QPainterPath path(stroker.createStroke(centerLine(glyph)));
+
+            // dots, as drawn by round capped pens
+            const GlyphData &data(s_glyphs[glyph]);
+            for (int i = 0; i < data.count; ++i)
+            {
+                const Line &line(data.lines[i]);
+                if (line.count == 1) path.addEllipse(QPointF(line.points[0].x, line.points[0].y), penWidth/2, penWidth/2);
+            }
+
+            path.setFillRule(Qt::WindingFill);
+            s_outlines.insert(key, path);
+            return path;
+        }
+
+        //__________________________________________________________________
+        const QPainterPath &area(Glyph glyph)
+        {
+            static const auto s_areas = []() {
+                std::array<QPainterPath, GlyphCount> areas;
+                for (int glyph = PinHead; glyph < GlyphCount; ++glyph)
+                { areas[glyph] = centerLine(static_cast<Glyph>(glyph)); }
+                return areas;
+            }();
+
+            return s_areas[glyph];
+        }
+
+        //__________________________________________________________________
+        void stroke(QPainter *painter, Glyph glyph, const QPen &pen)
+        { painter->fillPath(outline(glyph, pen.widthF()), pen.color()); }
+
+        //__________________________________________________________________
+        void fill(QPainter *painter, Glyph glyph, const QColor &color)
+        { painter->fillPath(area(glyph), color); }
+
+    }
+
+}
@@ -0,0 +1,81 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License or (at your option) version 3 or any later version
+ * accepted by the membership of KDE e.V. (or its successor approved
+ * by the membership of KDE e.V.), which shall act as a proxy
+ * defined in Section 14 of version 3 of the license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+#include <QColor>
+#include <QPainterPath>
+
+class QPainter;
+class QPen;
+
+namespace Breeze
+{
+
+    //* button symbols, in the normalized 18x18 button space
+    namespace ButtonGlyphs
+    {
+
+        enum Glyph
+        {
+            //*@name stroked glyphs
+            //@{
+            Close,
+            CloseSmall,
+            Maximize,
+            Restore,
+            Minimize,
+            MinimizeSmall,
+            Shade,
+            Unshade,
+            KeepBelow,
+            KeepBelowSmall,
+            KeepAbove,
+            KeepAboveSmall,
+            ApplicationMenu,
+            ApplicationMenuSmall,
+            ContextHelp,
+            PinNeedle,
+            //@}
+
+            //*@name filled glyphs
+            //@{
+            PinHead,
+            MaximizeTriangles,
+            RestoreTriangles,
+            //@}
+
+            GlyphCount
+        };
+
+        //* outline of a stroked glyph for given pen width, stroked once and cached. The width is rounded to 1/64th
+        QPainterPath outline(Glyph glyph, qreal penWidth);
+
+        //* area of a filled glyph
+        const QPainterPath &area(Glyph glyph);
+
+        //* draw stroked glyph with given pen color and width. The pen is expected to use round caps and miter joins
+        void stroke(QPainter *painter, Glyph glyph, const QPen &pen);
+
+        //* draw filled glyph
+        void fill(QPainter *painter, Glyph glyph, const QColor &color);
+
+    }
+
+}
@@ -0,0 +1,354 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License or (at your option) version 3 or any later version
+ * accepted by the membership of KDE e.V. (or its successor approved
+ * by the membership of KDE e.V.), which shall act as a proxy
+ * defined in Section 14 of version 3 of the license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "breezebuttonstyleengine.h"
+
+#include <QHash>
+#include <QImage>
+#include <QLinearGradient>
+#include <QPainter>
+#include <QRadialGradient>
+#include <QTransform>
+#include <QtMath>
+
+#include <array>
+#include <cmath>
+
+namespace Breeze
+{
+
+    namespace ButtonStyleEngine
+    {
+
+        using KDecoration3::DecorationButtonType;
+
+        namespace
+        {
+
+            //* gradient stops, top and bottom
+            struct Stops
+            {
+                QRgb top;
+                QRgb bottom;
+            };
+
+            //* palette colors, for each tone, for checked buttons (if any), and base color of glossy discs
+            struct PaletteColors
+            {
+                Stops tones[2];
+                Stops checked;
+                QRgb gloss;
+            };
+
+            constexpr PaletteColors s_palettes[PaletteCount] =
+            {
+                // Red
+                { { { qRgb(255, 92, 87), qRgb(233, 84, 79) }, { qRgb(250, 100, 102), qRgb(230, 92, 94) } }, { 0, 0 }, qRgb(255, 92, 87) },
+                // Green
+                { { { qRgb(40, 211, 63), qRgb(36, 191, 57) }, { qRgb(124, 198, 67), qRgb(111, 178, 60) } }, { qRgb(67, 198, 176), qRgb(60, 178, 159) }, qRgb(39, 201, 63) },
+                // Yellow
+                { { { qRgb(243, 176, 43), qRgb(223, 162, 39) }, { qRgb(237, 198, 81), qRgb(217, 181, 74) } }, { 0, 0 }, qRgb(255, 189, 46) },
+                // Blue
+                { { { qRgb(103, 149, 210), qRgb(93, 135, 190) }, { qRgb(135, 166, 220), qRgb(122, 151, 200) } }, { 0, 0 }, qRgb(103, 149, 210) },
+                // Orange
+                { { { qRgb(230, 129, 67), qRgb(210, 118, 61) }, { qRgb(250, 145, 100), qRgb(230, 131, 92) } }, { 0, 0 }, qRgb(230, 129, 67) }
+            };
+
+            //* layers per button type
+            struct StyleEntry
+            {
+                DecorationButtonType type;
+                DiscLayer layer;
+            };
+
+            constexpr StyleEntry s_plainStyle[] =
+            {
+                { DecorationButtonType::Close, { Red, ToneGrayAbove100, PressedVisible } },
+                { DecorationButtonType::Maximize, { Green, ToneGrayAbove100, PressedVisible } },
+                { DecorationButtonType::Minimize, { Yellow, ToneGrayAbove100, PressedVisible } },
+                { DecorationButtonType::OnAllDesktops, { Blue, ToneGrayAbove100, MacOSOnly|CheckedFull } },
+                { DecorationButtonType::Shade, { Blue, ToneGrayAbove100, MacOSOnly|CheckedFull } },
+                { DecorationButtonType::KeepBelow, { Blue, ToneGrayAbove100, MacOSOnly|CheckedFull|CheckedMacOS } },
+                { DecorationButtonType::KeepAbove, { Blue, ToneGrayAbove100, MacOSOnly|CheckedFull } },
+                { DecorationButtonType::ApplicationMenu, { Orange, ToneGrayAbove100, MacOSOnly } },
+                { DecorationButtonType::ContextHelp, { Blue, ToneGrayAbove100, MacOSOnly } }
+            };
+
+            constexpr StyleEntry s_aquaStyle[] =
+            {
+                { DecorationButtonType::Close, { Red, ToneGrayAbove100, MacOSOnly|PressedVisible|Glossy } },
+                { DecorationButtonType::Maximize, { Green, ToneGrayAbove100, MacOSOnly|PressedVisible|Glossy } },
+                { DecorationButtonType::Minimize, { Yellow, ToneGrayAbove100, MacOSOnly|PressedVisible|Glossy } },
+                { DecorationButtonType::OnAllDesktops, { Blue, ToneGrayAbove100, MacOSOnly|CheckedFull } },
+                { DecorationButtonType::Shade, { Blue, ToneGrayAbove100, MacOSOnly|CheckedFull } },
+                { DecorationButtonType::KeepBelow, { Blue, ToneGrayAbove100, MacOSOnly|CheckedFull|CheckedMacOS } },
+                { DecorationButtonType::KeepAbove, { Blue, ToneGrayAbove100, MacOSOnly|CheckedFull } },
+                { DecorationButtonType::ApplicationMenu, { Orange, ToneGrayAbove100, MacOSOnly } },
+                { DecorationButtonType::ContextHelp, { Blue, ToneGrayAbove100, MacOSOnly } }
+            };
+
+            constexpr StyleEntry s_sierraStyle[] =
+            {
+                { DecorationButtonType::Close, { Red, ToneGrayBelow128, MacOSOnly|PressedVisible } },
+                { DecorationButtonType::Maximize, { Green, ToneGrayBelow128, MacOSOnly|PressedVisible } },
+                { DecorationButtonType::Minimize, { Yellow, ToneGrayBelow128, MacOSOnly|PressedVisible } },
+                { DecorationButtonType::OnAllDesktops, { Blue, ToneGrayAbove100, MacOSOnly|CheckedFull } },
+                { DecorationButtonType::Shade, { Blue, ToneGrayAbove100, MacOSOnly|CheckedFull } },
+                { DecorationButtonType::KeepBelow, { Blue, ToneGrayAbove100, MacOSOnly|CheckedFull|CheckedMacOS } },
+                { DecorationButtonType::KeepAbove, { Blue, ToneGrayAbove100, MacOSOnly|CheckedFull } },
+                { DecorationButtonType::ApplicationMenu, { Orange, ToneGrayAbove100, MacOSOnly } },
+                { DecorationButtonType::ContextHelp, { Blue, ToneGrayAbove100, MacOSOnly } }
+            };
+
+            //* symbols per button type, shared by the macOS like styles
+            struct SymbolEntry
+            {
+                DecorationButtonType type;
+                SymbolLayer layer;
+            };
+
+            using namespace ButtonGlyphs;
+            constexpr SymbolEntry s_macOSSymbols[] =
+            {
+                { DecorationButtonType::Close, { CloseSmall, CloseSmall, Close, Close, HoveredOnly } },
+                { DecorationButtonType::Maximize, { MaximizeTriangles, RestoreTriangles, Maximize, Restore, HoveredOnly|FilledMacOS|HoveredBold } },
+                { DecorationButtonType::Minimize, { MinimizeSmall, MinimizeSmall, Minimize, Minimize, HoveredOnly|HoveredBold } },
+                { DecorationButtonType::OnAllDesktops, { PinHead, PinHead, PinHead, PinHead, CheckedVisible|Pin } },
+                { DecorationButtonType::Shade, { Shade, Unshade, Shade, Unshade, CheckedVisible } },
+                { DecorationButtonType::KeepBelow, { KeepBelowSmall, KeepBelowSmall, KeepBelow, KeepBelow, CheckedVisible } },
+                { DecorationButtonType::KeepAbove, { KeepAboveSmall, KeepAboveSmall, KeepAbove, KeepAbove, CheckedVisible } },
+                { DecorationButtonType::ApplicationMenu, { ApplicationMenuSmall, ApplicationMenuSmall, ApplicationMenu, ApplicationMenu, 0 } },
+                { DecorationButtonType::ContextHelp, { ContextHelp, ContextHelp, ContextHelp, ContextHelp, 0 } }
+            };
+
+            //* find layer in a style table
+            template<typename Entry, size_t N>
+            auto findLayer(const Entry (&entries)[N], DecorationButtonType type) -> decltype(&entries[0].layer)
+            {
+                for (const auto &entry : entries)
+                { if (entry.type == type) return &entry.layer; }
+                return nullptr;
+            }
+
+            //* gradients, compiled once from the palette table
+            const QLinearGradient &gradient(Palette palette, int variant)
+            {
+                static const auto s_gradients = []() {
+                    std::array<std::array<QLinearGradient, 3>, PaletteCount> gradients;
+                    for (int index = 0; index < PaletteCount; ++index)
+                    {
+                        const PaletteColors &colors(s_palettes[index]);
+                        const Stops variants[3] = { colors.tones[0], colors.tones[1], colors.checked.top ? colors.checked : colors.tones[0] };
+                        for (int variant = 0; variant < 3; ++variant)
+                        {
+                            QLinearGradient grad(QPointF(9, 2), QPointF(9, 16));
+                            grad.setColorAt(0, QColor(variants[variant].top));
+                            grad.setColorAt(1, QColor(variants[variant].bottom));
+                            gradients[index][variant] = grad;
+                        }
+                    }
+                    return gradients;
+                }();
+
+                return s_gradients[palette][variant];
+            }
+
+            //* flattened Aqua disc
+            struct AquaKey
+            {
+                QRgb baseColor = 0;
+                bool emphasized = false;
+
+                //* device pixels per unit of the normalized button space
+                qreal scale = 1;
+
+                //* position of the disc within its device pixel
+                QPointF phase;
+
+                bool operator==(const AquaKey &) const = default;
+            };
+
+            size_t qHash(const AquaKey &key, size_t seed = 0)
+            { return qHashMulti(seed, key.baseColor, key.emphasized, key.scale, key.phase.x(), key.phase.y()); }
+
+            //* maximum number of cached discs, the cache is reset when exceeded
+            constexpr int MaxAquaDiscs = 128;
+
+            QHash<AquaKey, QImage> &aquaDiscs()
+            {
+                static QHash<AquaKey, QImage> s_discs;
+                return s_discs;
+            }
+
+            //* Aqua layer stack: radial base, gloss, shadow and inner bevel
+            void renderAquaLayers(QPainter *painter, const QColor &baseColor)
+            {
+                const QRectF r(0, 0, 18, 18);
+
+                // radial base, brighter at the bottom
+                QRadialGradient base(r.center(), r.width()/2, QPointF(r.center().x(), r.bottom()));
+                base.setColorAt(0.0, baseColor.lighter(110));
+                base.setColorAt(0.6, baseColor);
+                base.setColorAt(1.0, baseColor.darker(110));
+                painter->setBrush(base);
+                painter->setPen(QColor(0, 0, 0, 80));
+                painter->drawEllipse(r);
+
+                // gloss
+                const QRectF highlightRect(r.left()+4, r.top()+1, r.width()-8, r.height()/2.5);
+                QLinearGradient gloss(highlightRect.topLeft(), highlightRect.bottomLeft());
+                gloss.setColorAt(0.0, QColor(255, 255, 255, 180));
+                gloss.setColorAt(1.0, QColor(255, 255, 255, 0));
+                painter->setBrush(gloss);
+                painter->setPen(Qt::NoPen);
+                painter->drawEllipse(highlightRect);
+
+                // shadow
+                QLinearGradient shadow(r.topLeft(), r.bottomLeft());
+                shadow.setColorAt(0.0, QColor(0, 0, 0, 0));
+                shadow.setColorAt(1.0, QColor(0, 0, 0, 80));
+                painter->setBrush(shadow);
+                painter->drawEllipse(r);
+
+                // inner bevel
+                const QRectF bevelRect(r.left()+2, r.top()+r.height()/1.9, r.width()-4, r.height()/2.2);
+                QRadialGradient innerHighlight(r.center(), r.width()/2, r.center());
+                innerHighlight.setColorAt(0.0, QColor(255, 255, 255, 0));
+                innerHighlight.setColorAt(1.0, QColor(255, 255, 255, 50));
+                painter->setBrush(innerHighlight);
+                painter->drawEllipse(bevelRect);
+            }
+
+        }
+
+        //__________________________________________________________________
+        const DiscLayer *discLayer(int style, DecorationButtonType type)
+        {
+            switch (style)
+            {
+                case 0: return findLayer(s_plainStyle, type);
+                case 1: return findLayer(s_aquaStyle, type);
+                case 2: return findLayer(s_sierraStyle, type);
+                default: return nullptr;
+            }
+        }
+
+        //__________________________________________________________________
+        const SymbolLayer *symbolLayer(int style, DecorationButtonType type)
+        {
+            switch (style)
+            {
+                case 1:
+                case 2: return findLayer(s_macOSSymbols, type);
+                default: return nullptr;
+            }
+        }
+
+        //__________________________________________________________________
+        void drawDiscLayer(QPainter *painter, const DiscLayer &layer, const DiscState &state)
+        {
+            const bool macOS = state.macOS || ((layer.flags & CheckedMacOS) && state.checked);
+            if ((layer.flags & MacOSOnly) && !macOS) return;
+            if (state.pressed && !(layer.flags & PressedVisible)) return;
+
+            if (layer.flags & Glossy)
+            {
+                drawAquaDisc(painter, state.inactive ? state.inactiveColor : QColor(s_palettes[layer.palette].gloss), state.backgroundColor.isValid());
+                return;
+            }
+
+            painter->setPen(Qt::NoPen);
+            if (state.inactive) painter->setBrush(state.inactiveColor);
+            else if (state.checked && s_palettes[layer.palette].checked.top) painter->setBrush(gradient(layer.palette, 2));
+            else
+            {
+                const bool firstTone = layer.tone == ToneGrayAbove100 ? state.titleBarGray > 100 : state.titleBarGray < 128;
+                painter->setBrush(gradient(layer.palette, firstTone ? 0 : 1));
+            }
+
+            if (state.checked && (layer.flags & CheckedFull))
+            {
+                painter->drawEllipse(QRectF(0, 0, 18, 18));
+                return;
+            }
+
+            painter->drawEllipse(QRectF(1, 1, 16, 16));
+            if (state.backgroundColor.isValid())
+            {
+                painter->setBrush(state.backgroundColor);
+                const qreal r = static_cast<qreal>(7)
+                    + ((layer.flags & PressedVisible) && state.pressed ? 0.0
+                       : static_cast<qreal>(2) * state.progress);
+                painter->drawEllipse(QPointF(9, 9), r, r);
+            }
+        }
+
+        //__________________________________________________________________
+        void drawAquaDisc(QPainter *painter, const QColor &baseColor, bool emphasized)
+        {
+            // resolution and position of the normalized button space on the device
+            const QTransform &transform(painter->deviceTransform());
+            const qreal scale = transform.m11();
+            const QPointF origin(transform.map(QPointF(0, 0)));
+
+            /*
+            the disc is rendered at its exact scale and sub pixel position, and blitted to whole device pixels,
+            so that it is identical to direct rendering. The outline is stroked across the disc edge, so the
+            image has a margin for it
+            */
+            AquaKey key;
+            key.baseColor = baseColor.rgba();
+            key.emphasized = emphasized;
+            key.scale = scale;
+            key.phase = QPointF(origin.x() - std::floor(origin.x()), origin.y() - std::floor(origin.y()));
+
+            const int margin = qCeil(scale/2) + 1;
+            const int pixelSize = qCeil(18*scale) + 2*margin;
+
+            auto &discs(aquaDiscs());
+            auto it = discs.constFind(key);
+            if (it == discs.constEnd())
+            {
+                if (discs.size() >= MaxAquaDiscs) discs.clear();
+
+                QImage image(pixelSize, pixelSize, QImage::Format_ARGB32_Premultiplied);
+                image.fill(Qt::transparent);
+
+                QPainter p(&image);
+                p.setRenderHints(QPainter::Antialiasing);
+                p.translate(margin + key.phase.x(), margin + key.phase.y());
+                p.scale(scale, scale);
+                renderAquaLayers(&p, baseColor);
+                if (emphasized) renderAquaLayers(&p, baseColor);
+                p.end();
+
+                it = discs.insert(key, image);
+            }
+
+            const QPointF topLeft(-(margin + key.phase.x())/scale, -(margin + key.phase.y())/scale);
+            painter->drawImage(QRectF(topLeft, QSizeF(pixelSize/scale, pixelSize/scale)), it.value());
+            painter->setPen(Qt::NoPen);
+        }
+
+        //__________________________________________________________________
+        void clearCache()
+        { aquaDiscs().clear(); }
+
+    }
+
+}
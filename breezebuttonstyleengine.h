@@ -0,0 +1,152 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License or (at your option) version 3 or any later version
+ * accepted by the membership of KDE e.V. (or its successor approved
+ * by the membership of KDE e.V.), which shall act as a proxy
+ * defined in Section 14 of version 3 of the license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "breezebuttonglyphs.h"
+
+#include <KDecoration3/DecorationButton>
+
+#include <QColor>
+
+class QPainter;
+
+namespace Breeze
+{
+
+    //* declarative description of the colored discs and symbols of macOS like buttons
+    namespace ButtonStyleEngine
+    {
+
+        //* disc colors
+        enum Palette
+        {
+            Red,
+            Green,
+            Yellow,
+            Blue,
+            Orange,
+            PaletteCount
+        };
+
+        //* which title bars get the first set of gradient stops
+        enum Tone
+        {
+            ToneGrayAbove100,
+            ToneGrayBelow128
+        };
+
+        //* layer flags
+        enum LayerFlag
+        {
+            //* only drawn in macOS mode
+            MacOSOnly = 1<<0,
+
+            //* also drawn while pressed, without growing the hover disc
+            PressedVisible = 1<<1,
+
+            //* checked buttons get a full size disc and no hover disc
+            CheckedFull = 1<<2,
+
+            //* checked buttons are always drawn in macOS mode
+            CheckedMacOS = 1<<3,
+
+            //* glossy disc, see drawAquaDisc
+            Glossy = 1<<4
+        };
+
+        //* disc layer of a button type in a given style
+        struct DiscLayer
+        {
+            Palette palette;
+            Tone tone;
+            int flags;
+        };
+
+        //* button state needed to render a disc layer
+        struct DiscState
+        {
+            int titleBarGray = 0;
+            bool macOS = false;
+            bool checked = false;
+            bool pressed = false;
+            bool inactive = false;
+            QColor inactiveColor;
+            QColor backgroundColor;
+            qreal progress = 0;
+        };
+
+        //* symbol flags
+        enum SymbolFlag
+        {
+            //* in macOS mode, only drawn while hovered, the disc showing the other states
+            HoveredOnly = 1<<0,
+
+            //* in macOS mode, also drawn while checked
+            CheckedVisible = 1<<1,
+
+            //* the macOS mode glyphs are filled rather than stroked
+            FilledMacOS = 1<<2,
+
+            //* thicker pen while hovered
+            HoveredBold = 1<<3,
+
+            //* drawn as a pin, or a dot in macOS mode, rather than from the glyphs
+            Pin = 1<<4
+        };
+
+        //* symbol drawn over the disc of a button type in a given style
+        struct SymbolLayer
+        {
+            //*@name glyphs in macOS mode, unchecked and checked
+            //@{
+            ButtonGlyphs::Glyph macOSGlyph;
+            ButtonGlyphs::Glyph macOSCheckedGlyph;
+            //@}
+
+            //*@name glyphs otherwise, unchecked and checked
+            //@{
+            ButtonGlyphs::Glyph glyph;
+            ButtonGlyphs::Glyph checkedGlyph;
+            //@}
+
+            int flags;
+        };
+
+        //* disc layer of given button style and type, nullptr if none
+        const DiscLayer *discLayer(int style, KDecoration3::DecorationButtonType type);
+
+        //* symbol layer of given button style and type, nullptr if none
+        const SymbolLayer *symbolLayer(int style, KDecoration3::DecorationButtonType type);
+
+        //* render disc layer, in the normalized 18x18 button space
+        void drawDiscLayer(QPainter *painter, const DiscLayer &layer, const DiscState &state);
+
+        //* render the glossy disc of the Aqua close, maximize and minimize buttons, in the normalized 18x18 button space
+        /**
+        the layers are flattened once per color, emphasis, resolution and sub pixel position, and blitted afterwards.
+        Emphasized discs (hovered, pressed) have their layer stack applied twice
+        */
+        void drawAquaDisc(QPainter *painter, const QColor &baseColor, bool emphasized);
+
+        //* drop cached Aqua discs
+        void clearCache();
+
+    }
+
+}
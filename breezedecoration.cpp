@@ -25,8 +25,12 @@
 #include "config/breezeconfigwidget.h"
 
 #include "breezebutton.h"
+#include "breezebuttonatlas.h"
+#include "breezebuttonstyleengine.h"
 
 #include "breezeboxshadowrenderer.h"
+#include "breezeinstrumentation.h"
+#include "breezeroundedregion.h"
 
 #include <KDecoration3/DecorationButtonGroup>
 #include <KDecoration3/DecorationShadow>
@@ -152,6 +156,7 @@ namespace Breeze
         : KDecoration3::Decoration(parent, args)
     {
         g_sDecoCount++;
+        Instrumentation::startReporting();
     }
 
     //________________________________________________________________
@@ -162,6 +167,10 @@ namespace Breeze
             // last deco destroyed, clean up shadow
             g_sShadow.reset();
             g_sShadowInactive.reset();
+            // the buttons, destroyed after this, release their images
+            ButtonAtlas::self().drain();
+            ButtonStyleEngine::clearCache();
+            Instrumentation::report();
         }
     }
 
@@ -191,68 +200,133 @@ namespace Breeze
         const auto w = window();
 
         reconfigure();
-        updateTitleBar();
         auto s = settings();
-        connect(s.get(), &KDecoration3::DecorationSettings::borderSizeChanged, this, &Decoration::recalculateBorders);
 
         // a change in font might cause the borders to change
-        recalculateBorders();
-        resetBlurRegion();
-        connect(s.get(), &KDecoration3::DecorationSettings::fontChanged, this, &Decoration::recalculateBorders);
-        connect(s.get(), &KDecoration3::DecorationSettings::spacingChanged, this, &Decoration::recalculateBorders);
+        connect(s.get(), &KDecoration3::DecorationSettings::borderSizeChanged, this, [this]() {
+            scheduleUpdate(DirtyBorders|DirtyBlurRegion);
+        });
+        connect(s.get(), &KDecoration3::DecorationSettings::fontChanged, this, [this]() {
+            scheduleUpdate(DirtyBorders|DirtyButtons|DirtyBlurRegion);
+            update();
+        });
+        connect(s.get(), &KDecoration3::DecorationSettings::spacingChanged, this, [this]() {
+            scheduleUpdate(DirtyBorders|DirtyButtons|DirtyBlurRegion);
+        });
 
         // buttons
-        connect(s.get(), &KDecoration3::DecorationSettings::spacingChanged, this, &Decoration::updateButtonsGeometryDelayed);
-        connect(s.get(), &KDecoration3::DecorationSettings::decorationButtonsLeftChanged, this, &Decoration::updateButtonsGeometryDelayed);
-        connect(s.get(), &KDecoration3::DecorationSettings::decorationButtonsRightChanged, this, &Decoration::updateButtonsGeometryDelayed);
+        connect(s.get(), &KDecoration3::DecorationSettings::decorationButtonsLeftChanged, this, [this]() {
+            scheduleUpdate(DirtyButtons);
+        });
+        connect(s.get(), &KDecoration3::DecorationSettings::decorationButtonsRightChanged, this, [this]() {
+            scheduleUpdate(DirtyButtons);
+        });
 
         // full reconfiguration
-        connect(s.get(), &KDecoration3::DecorationSettings::reconfigured, this, &Decoration::reconfigure);
-        connect(s.get(), &KDecoration3::DecorationSettings::reconfigured, SettingsProvider::self(), &SettingsProvider::reconfigure, Qt::UniqueConnection);
-        connect(s.get(), &KDecoration3::DecorationSettings::reconfigured, this, &Decoration::updateButtonsGeometryDelayed);
-
-        connect(w, &KDecoration3::DecoratedWindow::adjacentScreenEdgesChanged, this, &Decoration::recalculateBorders);
-        connect(w, &KDecoration3::DecoratedWindow::maximizedHorizontallyChanged, this, &Decoration::recalculateBorders);
-        connect(w, &KDecoration3::DecoratedWindow::maximizedVerticallyChanged, this, &Decoration::recalculateBorders);
-        connect(w, &KDecoration3::DecoratedWindow::shadedChanged, this, &Decoration::recalculateBorders);
-
-        connect(w, &KDecoration3::DecoratedWindow::captionChanged, this, [this]() {
-            // update the caption area
-            update(titleBar());
+        // the provider reloads the configuration once, then each decoration applies what changed for its window
+        connect(s.get(), &KDecoration3::DecorationSettings::reconfigured, SettingsProvider::self(), &SettingsProvider::scheduleReconfigure, Qt::UniqueConnection);
+        connect(SettingsProvider::self(), &SettingsProvider::reconfigured, this, &Decoration::reconfigure);
+
+        connect(w, &KDecoration3::DecoratedWindow::adjacentScreenEdgesChanged, this, [this]() {
+            scheduleUpdate(DirtyBorders|DirtyTitleBar|DirtyButtons|DirtyBlurRegion);
+        });
+        connect(w, &KDecoration3::DecoratedWindow::maximizedHorizontallyChanged, this, [this]() {
+            scheduleUpdate(DirtyBorders|DirtyBlurRegion);
+        });
+        connect(w, &KDecoration3::DecoratedWindow::maximizedVerticallyChanged, this, [this]() {
+            scheduleUpdate(DirtyBorders|DirtyBlurRegion);
+        });
+        connect(w, &KDecoration3::DecoratedWindow::maximizedChanged, this, [this]() {
+            scheduleUpdate(DirtyTitleBar|DirtyButtons|DirtyBlurRegion);
+        });
+        connect(w, &KDecoration3::DecoratedWindow::shadedChanged, this, [this]() {
+            // hidden title bars show up when shaded, and the button colors depend on them
+            updateButtonColors();
+            scheduleUpdate(DirtyBorders|DirtyButtons|DirtyBlurRegion);
+            update();
+        });
+        connect(w, &KDecoration3::DecoratedWindow::widthChanged, this, [this]() {
+            scheduleUpdate(DirtyTitleBar|DirtyButtons|DirtyBlurRegion);
+        });
+        connect(w, &KDecoration3::DecoratedWindow::heightChanged, this, [this]() {
+            if (!hasNoSideBorders()) scheduleUpdate(DirtyBlurRegion);
+        });
+        connect(this, &KDecoration3::Decoration::bordersChanged, this, [this]() {
+            scheduleUpdate(DirtyTitleBar);
         });
 
-        connect(w, &KDecoration3::DecoratedWindow::activeChanged, this, &Decoration::updateActiveState);
-        connect(this, &KDecoration3::Decoration::bordersChanged, this, &Decoration::updateTitleBar);
-        connect(w, &KDecoration3::DecoratedWindow::adjacentScreenEdgesChanged, this, &Decoration::updateTitleBar);
-        connect(w, &KDecoration3::DecoratedWindow::widthChanged, this, &Decoration::updateTitleBar);
-        connect(w, &KDecoration3::DecoratedWindow::maximizedChanged, this, &Decoration::updateTitleBar);
-        //connect(w, &KDecoration3::DecoratedWindow::maximizedChanged, this, &Decoration::setOpaque);
+        // caption repaints are rate limited, some applications change their title many times a second
+        m_captionTimer = new QTimer(this);
+        m_captionTimer->setSingleShot(true);
+        connect(m_captionTimer, &QTimer::timeout, this, &Decoration::updateCaptionDelayed);
+        connect(w, &KDecoration3::DecoratedWindow::captionChanged, this, &Decoration::updateCaption);
 
-        connect(w, &KDecoration3::DecoratedWindow::widthChanged, this, &Decoration::updateButtonsGeometry);
-        connect(w, &KDecoration3::DecoratedWindow::maximizedChanged, this, &Decoration::updateButtonsGeometry);
-        connect(w, &KDecoration3::DecoratedWindow::adjacentScreenEdgesChanged, this, &Decoration::updateButtonsGeometry);
-        connect(w, &KDecoration3::DecoratedWindow::shadedChanged, this, &Decoration::updateButtonsGeometry);
-
-        connect(s.get(), &KDecoration3::DecorationSettings::borderSizeChanged, this, &Decoration::resetBlurRegion);
-        connect(s.get(), &KDecoration3::DecorationSettings::spacingChanged, this, &Decoration::resetBlurRegion);
-        connect(w, &KDecoration3::DecoratedWindow::adjacentScreenEdgesChanged, this, &Decoration::resetBlurRegion);
-        connect(w, &KDecoration3::DecoratedWindow::maximizedHorizontallyChanged, this, &Decoration::resetBlurRegion);
-        connect(w, &KDecoration3::DecoratedWindow::maximizedVerticallyChanged, this, &Decoration::resetBlurRegion);
-        connect(w, &KDecoration3::DecoratedWindow::maximizedChanged, this, &Decoration::resetBlurRegion);
-        connect(w, &KDecoration3::DecoratedWindow::shadedChanged, this, &Decoration::resetBlurRegion);
-        connect(w, &KDecoration3::DecoratedWindow::widthChanged, this, &Decoration::resetBlurRegion);
-        connect(w, &KDecoration3::DecoratedWindow::heightChanged, this, [this]() {
-            if (!hasNoSideBorders()) resetBlurRegion();
+        connect(w, &KDecoration3::DecoratedWindow::activeChanged, this, &Decoration::updateActiveState);
+        connect(w, &KDecoration3::DecoratedWindow::paletteChanged, this, [this]() {
+            updateButtonColors();
+            update();
         });
+        //connect(w, &KDecoration3::DecoratedWindow::maximizedChanged, this, &Decoration::setOpaque);
 
         connect(window(), &KDecoration3::DecoratedWindow::nextScaleChanged, this, &Decoration::updateScale);
 
-        createButtons();
-        updateShadow();
+        // borders, title bar and buttons must be known before the window is shown
+        updateDirtyState();
 
         return true;
     }
 
+    //________________________________________________________________
+    void Decoration::scheduleUpdate(int flags)
+    {
+        m_dirtyFlags |= flags;
+        if (m_updateScheduled || !m_dirtyFlags) return;
+
+        m_updateScheduled = true;
+        QMetaObject::invokeMethod(this, &Decoration::updateDirtyState, Qt::QueuedConnection);
+    }
+
+    //________________________________________________________________
+    void Decoration::updateDirtyState()
+    {
+        // the order matters: title bar, buttons and blur region depend on the borders,
+        // and bordersChanged marks the title bar dirty again within this same pass
+        if (m_dirtyFlags & DirtyBorders)
+        {
+            m_dirtyFlags &= ~DirtyBorders;
+            recalculateBorders();
+        }
+
+        if (m_dirtyFlags & DirtyTitleBar)
+        {
+            m_dirtyFlags &= ~DirtyTitleBar;
+            updateTitleBar();
+        }
+
+        if (m_dirtyFlags & DirtyButtons)
+        {
+            m_dirtyFlags &= ~DirtyButtons;
+            updateButtons();
+            updateButtonsGeometry();
+        }
+
+        if (m_dirtyFlags & DirtyBlurRegion)
+        {
+            m_dirtyFlags &= ~DirtyBlurRegion;
+            resetBlurRegion();
+        }
+
+        if (m_dirtyFlags & DirtyShadow)
+        {
+            m_dirtyFlags &= ~DirtyShadow;
+            updateShadow();
+        }
+
+        // anything invalidated by an earlier step is handled by the next pass
+        m_updateScheduled = false;
+        scheduleUpdate(0);
+    }
+
     //________________________________________________________________
     void Decoration::updateTitleBar()
     {
@@ -269,18 +343,65 @@ namespace Breeze
     //________________________________________________________________
     void Decoration::updateActiveState()
     {
-        updateShadow(); // active and inactive shadows are different
+        scheduleUpdate(DirtyShadow); // active and inactive shadows are different
         update();
     }
 
+    //________________________________________________________________
+    void Decoration::updateButtonColors()
+    {
+        const auto w = window();
+        const QColor warningColor(w->color(ColorGroup::Warning, ColorRole::Foreground));
+        for (const bool active : {false, true})
+        {
+            const ColorGroup group = active ? ColorGroup::Active : ColorGroup::Inactive;
+            const QColor titleBarColor(w->color(hideTitleBar() ? ColorGroup::Inactive : group, ColorRole::TitleBar));
+            m_buttonColors[active ? 1 : 0].update(titleBarColor, w->color(group, ColorRole::Foreground), warningColor);
+        }
+    }
+
+    //________________________________________________________________
+    void Decoration::updateCaption()
+    {
+        if (hideTitleBar()) return;
+
+        if (m_captionTimer->isActive())
+        {
+            // trailing update when the timer expires
+            m_captionUpdatePending = true;
+            return;
+        }
+
+        // only the caption area, the buttons are left alone
+        update(captionMaxRect());
+
+        const int interval = m_snapshot->captionRepaintInterval;
+        if (interval > 0) m_captionTimer->start(interval);
+    }
+
+    //________________________________________________________________
+    void Decoration::updateCaptionDelayed()
+    {
+        if (!m_captionUpdatePending) return;
+        m_captionUpdatePending = false;
+        updateCaption();
+    }
+
+    //________________________________________________________________
+    void Decoration::updateTitleException()
+    {
+        // settings, borders and shadow only change with the selected exception
+        if (SettingsProvider::self()->settingsSnapshot(this) != m_snapshot) reconfigure();
+    }
+
     //________________________________________________________________
     qreal Decoration::borderSize(bool bottom, qreal scale) const
     {
         const qreal pixelSize = KDecoration3::pixelSize(scale);
         const qreal baseSize = std::max<qreal>(pixelSize, KDecoration3::snapToPixelGrid(settings()->smallSpacing(), scale));
-        if (m_internalSettings && (m_internalSettings->mask() & BorderSize))
+        if (m_snapshot && (m_snapshot->mask & BorderSize))
         {
-            switch (m_internalSettings->borderSize()) {
+            switch (m_snapshot->borderSize) {
                 case InternalSettings::BorderNone: return 0;
                 case InternalSettings::BorderNoSides:
                     if (bottom)
@@ -332,18 +453,70 @@ namespace Breeze
     void Decoration::reconfigure()
     {
 
-        m_internalSettings = SettingsProvider::self()->internalSettings(this);
+        // only the parts affected by changed settings are updated
+        const auto snapshot = SettingsProvider::self()->settingsSnapshot(this);
+        const int changes = m_snapshot ? snapshot->changes(*m_snapshot) : SettingsSnapshot::AllChanges;
+        m_snapshot = snapshot;
 
-        setScaledCornerRadius();
+        // follow caption changes only if some exception depends on the window title
+        if (SettingsProvider::self()->hasTitleExceptions())
+        {
+            if (!m_titleExceptionTimer)
+            {
+                m_titleExceptionTimer = new QTimer(this);
+                m_titleExceptionTimer->setSingleShot(true);
+                m_titleExceptionTimer->setInterval(TitleExceptionInterval);
+                connect(m_titleExceptionTimer, &QTimer::timeout, this, &Decoration::updateTitleException);
+
+                // at most one re-evaluation per interval, whatever the caption change rate
+                connect(window(), &KDecoration3::DecoratedWindow::captionChanged, m_titleExceptionTimer, [this]() {
+                    if (!m_titleExceptionTimer->isActive()) m_titleExceptionTimer->start();
+                });
+            }
+
+        } else if (m_titleExceptionTimer) {
+
+            // also drops the caption connection
+            delete m_titleExceptionTimer;
+            m_titleExceptionTimer = nullptr;
+
+        }
+
+        if (!changes) return;
+
+        int flags = 0;
+        if (changes & SettingsSnapshot::BorderChange)
+        {
+            setScaledCornerRadius();
+            flags |= DirtyBorders|DirtyButtons|DirtyBlurRegion;
+        }
 
-        // borders
-        recalculateBorders();
+        if (changes & SettingsSnapshot::ButtonChange)
+        {
+            // existing buttons, new ones read the settings when created
+            if (m_leftButtons)
+            {
+                const auto buttons = m_leftButtons->buttons() + m_rightButtons->buttons();
+                for (KDecoration3::DecorationButton *button : buttons)
+                { static_cast<Button *>(button)->reconfigure(); }
+            }
 
-        // blur region
-        resetBlurRegion();
+            // the buttons are delayed because their size is also updated on reconfiguration
+            flags |= DirtyButtons;
+        }
 
-        // shadow
-        updateShadow();
+        if (changes & SettingsSnapshot::TitleBarChange)
+        {
+            // title bar colors may depend on the hide title bar setting
+            updateButtonColors();
+            flags |= DirtyBlurRegion;
+            update();
+        }
+
+        if (changes & SettingsSnapshot::ShadowChange)
+        { flags |= DirtyShadow; }
+
+        scheduleUpdate(flags);
 
     }
 
@@ -363,8 +536,7 @@ namespace Breeze
             top = bottom;
         else
         {
-            QFont f; f.fromString(m_internalSettings->titleBarFont());
-            QFontMetricsF fm(f);
+            QFontMetricsF fm(m_snapshot->titleBarFont());
             top += KDecoration3::snapToPixelGrid(std::max(fm.height(), static_cast<qreal>(buttonSize())), scale);
 
             // padding below
@@ -411,148 +583,105 @@ namespace Breeze
         // NOTE: "BlurEffect::decorationBlurRegion()" will consider the intersection of
         // the blur and decoration regions. Here we need to focus on corner rounding.
 
+        // the region only depends on its rect, corner radius and rounded corners
+        BlurRegionKey key;
+        const auto w = window();
         if (titleBarAlpha() == 255 || !settings()->isAlphaChannelSupported())
-        { // no blurring without translucency
-            setBlurRegion(QRegion());
-            return;
+        {
+            // no blurring without translucency
         }
-
-        QRegion region;
-        const auto w = window();
-        QSizeF rSize(m_scaledCornerRadius, m_scaledCornerRadius);
-
-        if (!w->isShaded() && !isMaximized() && !hasNoBorders())
+        else if (!w->isShaded() && !isMaximized() && !hasNoBorders())
         {
-            // exclude the titlebar
-            qreal topBorder = hideTitleBar() ? 0 : borderTop();
-            QRectF rect(0, topBorder, size().width(), size().height() - topBorder);
-
-            QRegion vert(QRectF(rect.topLeft() + QPointF(m_scaledCornerRadius, 0),
-                                QSizeF(rect.width() - 2*m_scaledCornerRadius, rect.height())).toRect());
-            QRegion topLeft, topRight, bottomLeft, bottomRight, horiz;
+            key.rect = rect().toRect();
+            key.radius = qRound(m_scaledCornerRadius);
             if (hasBorders())
             {
+                if (!(isLeftEdge() && isBottomEdge())) key.corners |= RoundedRegion::BottomLeft;
+                if (!(isRightEdge() && isBottomEdge())) key.corners |= RoundedRegion::BottomRight;
                 if (hideTitleBar())
                 {
-                    topLeft = QRegion(QRectF(rect.topLeft(), 2*rSize).toRect(),
-                                      isLeftEdge() ? QRegion::Rectangle : QRegion::Ellipse);
-                    topRight = QRegion(QRectF(rect.topLeft() + QPointF(rect.width() - 2*m_scaledCornerRadius, 0),
-                                              2*rSize).toRect(),
-                                       isRightEdge() ? QRegion::Rectangle : QRegion::Ellipse);
-                    horiz = QRegion(QRectF(rect.topLeft() + QPointF(0, m_scaledCornerRadius),
-                                           QSizeF(rect.width(), rect.height() - 2*m_scaledCornerRadius)).toRect());
-                }
-                else
-                { // "horiz" is at the top because the titlebar is excluded
-                    horiz = QRegion(QRectF(rect.topLeft(),
-                                           QSizeF(rect.width(), rect.height() - m_scaledCornerRadius)).toRect());
+                    if (!isLeftEdge()) key.corners |= RoundedRegion::TopLeft;
+                    if (!isRightEdge()) key.corners |= RoundedRegion::TopRight;
                 }
-                bottomLeft = QRegion(QRectF(rect.topLeft() + QPointF(0, rect.height() - 2*m_scaledCornerRadius),
-                                            2*rSize).toRect(),
-                                     isLeftEdge() && isBottomEdge() ? QRegion::Rectangle : QRegion::Ellipse);
-                bottomRight = QRegion(QRectF(rect.topLeft() + QPointF(rect.width() - 2*m_scaledCornerRadius,
-                                                                    rect.height() - 2*m_scaledCornerRadius),
-                                            2*rSize).toRect(),
-                                      isRightEdge() && isBottomEdge() ? QRegion::Rectangle : QRegion::Ellipse);
             }
-            else // no side border
+            else if (!isBottomEdge()) // no side border
             {
-                horiz = QRegion(QRectF(rect.topLeft(),
-                                       QSizeF(rect.width(), rect.height() - m_scaledCornerRadius)).toRect());
-                bottomLeft = QRegion(QRectF(rect.topLeft() + QPointF(0, rect.height() - 2*m_scaledCornerRadius),
-                                            2*rSize).toRect(),
-                                     isBottomEdge() ? QRegion::Rectangle : QRegion::Ellipse);
-                bottomRight = QRegion(QRectF(rect.topLeft() + QPointF(rect.width() - 2*m_scaledCornerRadius,
-                                                                      rect.height() - 2*m_scaledCornerRadius),
-                                             2*rSize).toRect(),
-                                      isBottomEdge() ? QRegion::Rectangle : QRegion::Ellipse);
+                key.corners |= RoundedRegion::BottomLeft | RoundedRegion::BottomRight;
             }
 
-            region = topLeft
-                     .united(topRight)
-                     .united(bottomLeft)
-                     .united(bottomRight)
-                     .united(horiz)
-                     .united(vert);
-
-            if (hideTitleBar())
+            // the titlebar, if any, only decides about the top corners
+            if (!hideTitleBar())
             {
-                setBlurRegion(region);
-                return;
+                if (!isLeftEdge() && !isTopEdge()) key.corners |= RoundedRegion::TopLeft;
+                if (!isRightEdge() && !isTopEdge()) key.corners |= RoundedRegion::TopRight;
             }
         }
-
-        const QRectF titleRect(QPointF(0, 0), QSizeF(size().width(), borderTop()));
-
-        // add the titlebar
-        if (m_scaledCornerRadius == 0
-            || isMaximized()) // maximized + no border when maximized
+        else
         {
-            region |= QRegion(titleRect.toRect());
+            // only the titlebar
+            key.rect = QRectF(QPointF(0, 0), QSizeF(size().width(), borderTop())).toRect();
+            if (!isMaximized()) // maximized + no border when maximized
+            {
+                key.radius = qRound(m_scaledCornerRadius);
+                if (w->isShaded())
+                    key.corners = RoundedRegion::AllCorners;
+                else
+                {
+                    if (!isLeftEdge() && !isTopEdge()) key.corners |= RoundedRegion::TopLeft;
+                    if (!isRightEdge() && !isTopEdge()) key.corners |= RoundedRegion::TopRight;
+                }
+            }
         }
-        else if (w->isShaded())
+
+        if (key == m_blurRegionKey)
         {
-            QRegion topLeft(QRectF(titleRect.topLeft(), 2*rSize).toRect(), QRegion::Ellipse);
-            QRegion topRight(QRectF(titleRect.topLeft() + QPointF(titleRect.width() - 2*m_scaledCornerRadius, 0),
-                                    2*rSize).toRect(),
-                             QRegion::Ellipse);
-            QRegion bottomLeft(QRectF(titleRect.topLeft() + QPointF(0, titleRect.height() - 2*m_scaledCornerRadius),
-                                      2*rSize).toRect(),
-                               QRegion::Ellipse);
-            QRegion bottomRight(QRectF(titleRect.topLeft() + QPointF(titleRect.width() - 2*m_scaledCornerRadius,
-                                                                     titleRect.height() - 2*m_scaledCornerRadius),
-                                       2*rSize).toRect(),
-                                QRegion::Ellipse);
-            region = topLeft
-                     .united(topRight)
-                     .united(bottomLeft)
-                     .united(bottomRight)
-                     // vertical
-                     .united(QRectF(titleRect.topLeft() + QPointF(m_scaledCornerRadius, 0),
-                                    QSizeF(titleRect.width() - 2*m_scaledCornerRadius, titleRect.height())).toRect())
-                     // horizontal
-                     .united(QRectF(titleRect.topLeft() + QPointF(0, m_scaledCornerRadius),
-                                    QSizeF(titleRect.width(), titleRect.height() - 2*m_scaledCornerRadius)).toRect());
+            Instrumentation::count(Instrumentation::BlurRegionUpdatesSkipped);
+            return;
         }
-        else
+        m_blurRegionKey = key;
+
+        // different inputs may still give the same region, e.g. with a zero radius
+        const QRegion region = key.rect.isEmpty() ? QRegion() : RoundedRegion::build(key.rect, key.radius, key.corners);
+        if (region == m_blurRegion)
         {
-            QRegion topLeft(QRectF(titleRect.topLeft(), 2*rSize).toRect(),
-                            isLeftEdge() || isTopEdge() ? QRegion::Rectangle : QRegion::Ellipse);
-            QRegion topRight(QRectF(titleRect.topLeft() + QPointF(titleRect.width() - 2*m_scaledCornerRadius, 0),
-                                    2*rSize).toRect(),
-                             isRightEdge() || isTopEdge() ? QRegion::Rectangle : QRegion::Ellipse);
-            region |= topLeft
-                      .united(topRight)
-                      // vertical
-                      .united(QRectF(titleRect.topLeft() + QPointF(m_scaledCornerRadius, 0),
-                                     QSizeF(titleRect.width() - 2*m_scaledCornerRadius, titleRect.height())).toRect())
-                      // horizontal
-                      .united(QRectF(titleRect.topLeft() + QPointF(0, m_scaledCornerRadius),
-                                     QSizeF(titleRect.width(), titleRect.height() - m_scaledCornerRadius)).toRect());
+            Instrumentation::count(Instrumentation::BlurRegionUpdatesSkipped);
+            return;
         }
 
+        m_blurRegion = region;
         setBlurRegion(region);
     }
 
     //________________________________________________________________
-    void Decoration::createButtons()
+    void Decoration::updateButtons()
     {
-        m_leftButtons = new KDecoration3::DecorationButtonGroup(KDecoration3::DecorationButtonGroup::Position::Left, this, &Button::create);
-        m_rightButtons = new KDecoration3::DecorationButtonGroup(KDecoration3::DecorationButtonGroup::Position::Right, this, &Button::create);
-        updateButtonsGeometry();
-    }
+        // buttons only exist while the title bar is shown
+        if (hideTitleBar())
+        {
+            if (!m_leftButtons) return;
 
-    //________________________________________________________________
-    void Decoration::updateButtonsGeometryDelayed()
-    {
-        QTimer::singleShot(0, this, &Decoration::updateButtonsGeometry);
+            m_leftButtons->deleteLater();
+            m_rightButtons->deleteLater();
+            m_leftButtons = nullptr;
+            m_rightButtons = nullptr;
+        }
+        else if (!m_leftButtons)
+        {
+            m_leftButtons = new KDecoration3::DecorationButtonGroup(KDecoration3::DecorationButtonGroup::Position::Left, this, &Button::create);
+            m_rightButtons = new KDecoration3::DecorationButtonGroup(KDecoration3::DecorationButtonGroup::Position::Right, this, &Button::create);
+        }
     }
 
     //________________________________________________________________
     void Decoration::updateButtonsGeometry()
     {
+        if (!m_leftButtons) return;
+
         const auto s = settings();
 
+        // the size follows the grid unit, which changes with the font and spacing
+        const QSizeF preferredSize(buttonSize(), buttonSize());
+
         // adjust button position
         const auto buttonList = m_leftButtons->buttons() + m_rightButtons->buttons();
         for (KDecoration3::DecorationButton *button : buttonList)
@@ -561,7 +690,7 @@ namespace Breeze
 
             const int verticalOffset = (isTopEdge() ? s->smallSpacing() * Metrics::TitleBar_TopMargin : 0);
 
-            const QSizeF preferredSize = btn->preferredSize();
+            btn->setPreferredSize(preferredSize);
             const int bHeight = preferredSize.height() + verticalOffset;
             const int bWidth = preferredSize.width();
 
@@ -573,7 +702,7 @@ namespace Breeze
         if (!m_leftButtons->buttons().isEmpty())
         {
             // spacing (use our own spacing instead of s->smallSpacing()*Metrics::TitleBar_ButtonSpacing)
-            m_leftButtons->setSpacing(m_internalSettings->buttonSpacing());
+            m_leftButtons->setSpacing(m_snapshot->buttonSpacing);
 
             // padding
             const int vPadding = isTopEdge() ? 0 : s->smallSpacing() * Metrics::TitleBar_TopMargin;
@@ -598,7 +727,7 @@ namespace Breeze
         if (!m_rightButtons->buttons().isEmpty())
         {
             // spacing (use our own spacing instead of s->smallSpacing()*Metrics::TitleBar_ButtonSpacing)
-            m_rightButtons->setSpacing(m_internalSettings->buttonSpacing());
+            m_rightButtons->setSpacing(m_snapshot->buttonSpacing);
 
             // padding
             const int vPadding = isTopEdge() ? 0 : s->smallSpacing() * Metrics::TitleBar_TopMargin;
@@ -682,35 +811,18 @@ namespace Breeze
         painter->setPen(Qt::NoPen);
 
         // render a linear gradient on title area and draw a light border at the top
-        if (m_internalSettings->drawBackgroundGradient() && !flatTitleBar())
-        {
-            QColor titleBarColor(this->titleBarColor());
-            titleBarColor.setAlpha(titleBarAlpha());
-
-            QLinearGradient gradient(0, 0, 0, titleRect.height());
-            QColor lightCol(titleBarColor.lighter(130 + m_internalSettings->backgroundGradientIntensity()));
-            gradient.setColorAt(0.0, lightCol);
-            gradient.setColorAt(0.99 / titleRect.height(), lightCol);
-            gradient.setColorAt(1.0 / titleRect.height(),
-                                titleBarColor.lighter(100 + m_internalSettings->backgroundGradientIntensity()));
-            gradient.setColorAt(1.0, titleBarColor);
+        // the factors already ignore the gradient intensity when it is disabled or the title bar is flat
+        QColor titleBarColor(this->titleBarColor());
+        titleBarColor.setAlpha(titleBarAlpha());
 
-            painter->setBrush(gradient);
-        }
-        else
-        {
-            QColor titleBarColor(this->titleBarColor());
-            titleBarColor.setAlpha(titleBarAlpha());
+        QLinearGradient gradient(0, 0, 0, titleRect.height());
+        QColor lightCol(titleBarColor.lighter(m_snapshot->gradientLightFactor));
+        gradient.setColorAt(0.0, lightCol);
+        gradient.setColorAt(0.99 / titleRect.height(), lightCol);
+        gradient.setColorAt(1.0 / titleRect.height(), titleBarColor.lighter(m_snapshot->gradientFactor));
+        gradient.setColorAt(1.0, titleBarColor);
 
-            QLinearGradient gradient(0, 0, 0, titleRect.height());
-            QColor lightCol(titleBarColor.lighter(130));
-            gradient.setColorAt(0.0, lightCol);
-            gradient.setColorAt(0.99 / titleRect.height(), lightCol);
-            gradient.setColorAt(1.0 / titleRect.height(), titleBarColor);
-            gradient.setColorAt(1.0, titleBarColor);
-
-            painter->setBrush(gradient);
-        }
+        painter->setBrush(gradient);
 
         auto s = settings();
         if (isMaximized() || !s->isAlphaChannelSupported())
@@ -736,25 +848,25 @@ namespace Breeze
         painter->restore();
 
         // draw caption
-        QFont f; f.fromString(m_internalSettings->titleBarFont());
-        // KDE needs this FIXME: Why?
-        QFontDatabase fd; f.setStyleName(fd.styleString(f));
-        painter->setFont(f);
+        painter->setFont(m_snapshot->captionFont());
         painter->setPen(fontColor());
         const auto cR = captionRect();
         const QString caption = painter->fontMetrics().elidedText(w->caption(), Qt::ElideMiddle, cR.first.width());
         painter->drawText(cR.first, cR.second | Qt::TextSingleLine, caption);
 
-        // draw all buttons
-        m_leftButtons->paint(painter, repaintRegion);
-        m_rightButtons->paint(painter, repaintRegion);
+        // draw all buttons, if already created
+        if (m_leftButtons)
+        {
+            m_leftButtons->paint(painter, repaintRegion);
+            m_rightButtons->paint(painter, repaintRegion);
+        }
     }
 
     //________________________________________________________________
     int Decoration::buttonSize() const
     {
         const int baseSize = settings()->gridUnit();
-        switch (m_internalSettings->buttonSize())
+        switch (m_snapshot->buttonSize)
         {
             case InternalSettings::ButtonTiny: return baseSize;
             case InternalSettings::ButtonSmall: return baseSize*1.5;
@@ -776,26 +888,32 @@ namespace Breeze
                                 - (w->isShaded() ? 0 : 1); // see recalculateBorders()
     }
 
+    //________________________________________________________________
+    QRectF Decoration::captionMaxRect() const
+    {
+        const qreal extraTitleMargin = m_snapshot->extraTitleMargin;
+        const qreal leftOffset = (!m_leftButtons || m_leftButtons->buttons().isEmpty()) ?
+            Metrics::TitleBar_SideMargin*settings()->smallSpacing() + extraTitleMargin :
+            m_leftButtons->geometry().x() + m_leftButtons->geometry().width() + Metrics::TitleBar_SideMargin*settings()->smallSpacing() + extraTitleMargin;
+
+        const qreal rightOffset = (!m_rightButtons || m_rightButtons->buttons().isEmpty()) ?
+            Metrics::TitleBar_SideMargin*settings()->smallSpacing() + extraTitleMargin:
+            size().width() - m_rightButtons->geometry().x() + Metrics::TitleBar_SideMargin*settings()->smallSpacing() + extraTitleMargin;
+
+        const qreal yOffset = settings()->smallSpacing()*Metrics::TitleBar_TopMargin;
+        return QRectF(leftOffset, yOffset, size().width() - leftOffset - rightOffset, captionHeight());
+    }
+
     //________________________________________________________________
     QPair<QRectF, Qt::Alignment> Decoration::captionRect() const
     {
         if (hideTitleBar()) return qMakePair(QRectF(), Qt::AlignCenter);
         else {
 
-            const qreal extraTitleMargin = m_internalSettings->extraTitleMargin();
             const auto w = window();
-            const qreal leftOffset = m_leftButtons->buttons().isEmpty() ?
-                Metrics::TitleBar_SideMargin*settings()->smallSpacing() + extraTitleMargin :
-                m_leftButtons->geometry().x() + m_leftButtons->geometry().width() + Metrics::TitleBar_SideMargin*settings()->smallSpacing() + extraTitleMargin;
-
-            const qreal rightOffset = m_rightButtons->buttons().isEmpty() ?
-                Metrics::TitleBar_SideMargin*settings()->smallSpacing() + extraTitleMargin:
-                size().width() - m_rightButtons->geometry().x() + Metrics::TitleBar_SideMargin*settings()->smallSpacing() + extraTitleMargin;
-
-            const qreal yOffset = settings()->smallSpacing()*Metrics::TitleBar_TopMargin;
-            const QRectF maxRect(leftOffset, yOffset, size().width() - leftOffset - rightOffset, captionHeight());
+            const QRectF maxRect = captionMaxRect();
 
-            switch (m_internalSettings->titleAlignment())
+            switch (m_snapshot->titleAlignment)
             {
                 case InternalSettings::AlignLeft:
                 return qMakePair(maxRect, Qt::AlignVCenter|Qt::AlignLeft);
@@ -811,19 +929,19 @@ namespace Breeze
                 {
 
                     // full caption rect
-                    const QRectF fullRect = QRectF(0, yOffset, size().width(), captionHeight());
-                    QFont f; f.fromString(m_internalSettings->titleBarFont());
-                    QFontMetricsF fm(f);
+                    // the text is only centered on it when it fits into maxRect
+                    const QRectF fullRect = QRectF(0, maxRect.top(), size().width(), captionHeight());
+                    QFontMetricsF fm(m_snapshot->titleBarFont());
                     QRectF boundingRect(fm.boundingRect(w->caption()));
 
                     // text bounding rect
-                    boundingRect.setTop(yOffset);
+                    boundingRect.setTop(maxRect.top());
                     boundingRect.setHeight(captionHeight());
                     boundingRect.moveLeft((size().width() - boundingRect.width())/2);
 
-                    if (boundingRect.left() < leftOffset)
+                    if (boundingRect.left() < maxRect.left())
                         return qMakePair(maxRect, Qt::AlignVCenter|Qt::AlignLeft);
-                    else if (boundingRect.right() > size().width() - rightOffset)
+                    else if (boundingRect.right() > maxRect.right())
                         return qMakePair(maxRect, Qt::AlignVCenter|Qt::AlignRight);
                     else
                         return qMakePair(fullRect, Qt::AlignCenter);
@@ -843,13 +961,13 @@ namespace Breeze
         auto &shadow = w->isActive() ? g_sShadow : g_sShadowInactive;
 
         if (!shadow
-            || g_shadowSizeEnum != m_internalSettings->shadowSize()
-            || g_shadowStrength != m_internalSettings->shadowStrength()
-            || g_shadowColor != m_internalSettings->shadowColor())
+            || g_shadowSizeEnum != m_snapshot->shadowSize
+            || g_shadowStrength != m_snapshot->shadowStrength
+            || g_shadowColor != m_snapshot->shadowColor)
         {
-            g_shadowSizeEnum = m_internalSettings->shadowSize();
-            g_shadowStrength = m_internalSettings->shadowStrength();
-            g_shadowColor = m_internalSettings->shadowColor();
+            g_shadowSizeEnum = m_snapshot->shadowSize;
+            g_shadowStrength = m_snapshot->shadowStrength;
+            g_shadowColor = m_snapshot->shadowColor;
 
             const CompositeShadowParams params = lookupShadowParams(g_shadowSizeEnum);
             if (params.isNone()) {
@@ -940,7 +1058,7 @@ namespace Breeze
     void Decoration::updateScale()
     {
         setScaledCornerRadius();
-        recalculateBorders();
+        scheduleUpdate(DirtyBorders|DirtyBlurRegion);
     }
 
 } // namespace
@@ -22,6 +22,8 @@
 #pragma once
 
 #include "breeze.h"
+#include "breezebuttoncolors.h"
+#include "breezesettingssnapshot.h"
 #include "breezesettings.h"
 
 #include <KDecoration3/DecoratedWindow>
@@ -29,6 +31,8 @@
 #include <KDecoration3/DecorationSettings>
 
 #include <QPalette>
+#include <QRegion>
+#include <QTimer>
 #include <QVariant>
 #include <QVariantAnimation>
 
@@ -55,9 +59,9 @@ namespace Breeze
         //* paint
         void paint(QPainter *painter, const QRectF &repaintRegion) override;
 
-        //* internal settings
-        InternalSettingsPtr internalSettings() const
-        { return m_internalSettings; }
+        //* effective settings
+        const SettingsSnapshot &settingsSnapshot() const
+        { return *m_snapshot; }
 
         //* caption height
         qreal captionHeight() const;
@@ -69,6 +73,10 @@ namespace Breeze
         //@{
         QColor titleBarColor() const;
         QColor fontColor() const;
+
+        //* button colors of the current title bar palette
+        const ButtonColors &buttonColors() const
+        { return m_buttonColors[window()->isActive() ? 1 : 0]; }
         //@}
 
         //*@name maximization modes
@@ -85,6 +93,17 @@ namespace Breeze
         inline bool hideTitleBar() const;
         //@}
 
+        //* derived state, recomputed once per event loop iteration
+        enum DirtyFlag
+        {
+            DirtyBorders = 1<<0,
+            DirtyTitleBar = 1<<1,
+            DirtyButtons = 1<<2,
+            DirtyBlurRegion = 1<<3,
+            DirtyShadow = 1<<4,
+            DirtyAll = DirtyBorders|DirtyTitleBar|DirtyButtons|DirtyBlurRegion|DirtyShadow
+        };
+
         public Q_SLOTS:
         bool init() override;
 
@@ -93,17 +112,31 @@ namespace Breeze
         void recalculateBorders();
         void resetBlurRegion();
         void updateButtonsGeometry();
-        void updateButtonsGeometryDelayed();
         void updateTitleBar();
         void updateActiveState();
         void updateScale();
+        void updateCaption();
+        void updateCaptionDelayed();
+        void updateTitleException();
+        void updateButtonColors();
+
+        //* recompute all derived state marked as dirty
+        void updateDirtyState();
 
         private:
 
+        //* mark derived state as dirty and schedule a deferred update pass
+        void scheduleUpdate(int flags);
+
         //* return the rect in which caption will be drawn
         QPair<QRectF,Qt::Alignment> captionRect() const;
 
-        void createButtons();
+        //* return the rect left for the caption between the buttons
+        QRectF captionMaxRect() const;
+
+        //* create the buttons when the title bar is shown, release them when hidden
+        void updateButtons();
+
         void paintTitleBar(QPainter *painter, const QRectF &repaintRegion);
         void updateShadow();
 
@@ -125,34 +158,64 @@ namespace Breeze
         inline int titleBarAlpha() const;
         //@}
 
-        InternalSettingsPtr m_internalSettings;
+        SettingsSnapshotPtr m_snapshot;
         KDecoration3::DecorationButtonGroup *m_leftButtons = nullptr;
         KDecoration3::DecorationButtonGroup *m_rightButtons = nullptr;
 
         //*frame corner radius, scaled according to DPI
         qreal m_scaledCornerRadius = 3;
+
+        //* inputs of the current blur region, to skip redundant updates
+        struct BlurRegionKey
+        {
+            QRect rect;
+            int radius = 0;
+            int corners = 0;
+
+            bool operator==(const BlurRegionKey &) const = default;
+        };
+
+        BlurRegionKey m_blurRegionKey;
+        QRegion m_blurRegion;
+
+        //* button colors, for inactive and active windows
+        ButtonColors m_buttonColors[2];
+
+        //* caption repaint rate limit
+        QTimer *m_captionTimer = nullptr;
+        bool m_captionUpdatePending = false;
+
+        //* window title exception re-evaluation, only exists when some exception matches titles
+        QTimer *m_titleExceptionTimer = nullptr;
+
+        //* minimum interval between title exception re-evaluations (ms)
+        static constexpr int TitleExceptionInterval = 200;
+
+        //* pending derived state updates, see DirtyFlag
+        int m_dirtyFlags = DirtyAll;
+        bool m_updateScheduled = false;
     };
 
     bool Decoration::hasBorders() const
     {
-        if (m_internalSettings && m_internalSettings->mask() & BorderSize)
-            return m_internalSettings->borderSize() > InternalSettings::BorderNoSides;
+        if (m_snapshot && m_snapshot->mask & BorderSize)
+            return m_snapshot->borderSize > InternalSettings::BorderNoSides;
         else
             return settings()->borderSize() > KDecoration3::BorderSize::NoSides;
     }
 
     bool Decoration::hasNoBorders() const
     {
-        if (m_internalSettings && m_internalSettings->mask() & BorderSize)
-            return m_internalSettings->borderSize() == InternalSettings::BorderNone;
+        if (m_snapshot && m_snapshot->mask & BorderSize)
+            return m_snapshot->borderSize == InternalSettings::BorderNone;
         else
             return settings()->borderSize() == KDecoration3::BorderSize::None;
     }
 
     bool Decoration::hasNoSideBorders() const
     {
-        if (m_internalSettings && m_internalSettings->mask() & BorderSize)
-            return m_internalSettings->borderSize() == InternalSettings::BorderNoSides;
+        if (m_snapshot && m_snapshot->mask & BorderSize)
+            return m_snapshot->borderSize == InternalSettings::BorderNoSides;
         else
             return settings()->borderSize() == KDecoration3::BorderSize::NoSides;
     }
@@ -197,23 +260,16 @@ namespace Breeze
     }
 
     bool Decoration::hideTitleBar() const
-    { return m_internalSettings->hideTitleBar() && !window()->isShaded(); }
+    { return m_snapshot->hideTitleBar && !window()->isShaded(); }
 
     bool Decoration::opaqueTitleBar() const
-    { return m_internalSettings->opaqueTitleBar(); }
+    { return m_snapshot->opaqueTitleBar; }
 
     bool Decoration::flatTitleBar() const
-    { return m_internalSettings->flatTitleBar(); }
+    { return m_snapshot->flatTitleBar; }
 
     int Decoration::titleBarAlpha() const
-    {
-        if (m_internalSettings->opaqueTitleBar())
-            return 255;
-        int a = m_internalSettings->opacityOverride() > -1 ? m_internalSettings->opacityOverride()
-                                                           : m_internalSettings->backgroundOpacity();
-        a =  qBound(0, a, 100);
-        return qRound(static_cast<qreal>(a) * static_cast<qreal>(2.55));
-    }
+    { return m_snapshot->titleBarAlpha; }
 
 }
 
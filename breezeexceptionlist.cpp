@@ -35,16 +35,10 @@ namespace Breeze
     {
         _exceptions.clear();
 
-        QString groupName;
-        for (int index = 0; config->hasGroup(groupName = exceptionGroupName(index)); ++index)
+        InternalSettings exception;
+        for (int index = 0; readException(config, index, exception); ++index)
         {
 
-            // create exception
-            InternalSettings exception;
-
-            // reset group
-            readConfig(&exception, config.data(), groupName);
-
             // create new configuration
             InternalSettingsPtr configuration(new InternalSettings());
             configuration.data()->load();
@@ -70,6 +64,16 @@ namespace Breeze
         }
     }
 
+    //______________________________________________________________
+    bool ExceptionList::readException(KSharedConfig::Ptr config, int index, InternalSettings &exception)
+    {
+        const QString groupName(exceptionGroupName(index));
+        if (!config->hasGroup(groupName)) return false;
+
+        readConfig(&exception, config.data(), groupName);
+        return true;
+    }
+
     //______________________________________________________________
     void ExceptionList::writeConfig(KSharedConfig::Ptr config)
     {
@@ -54,6 +54,9 @@ namespace Breeze
         //! write to kconfig
         void writeConfig(KSharedConfig::Ptr);
 
+        //! read exception with given index into skeleton, other settings are left alone. Returns false if there is none
+        static bool readException(KSharedConfig::Ptr, int index, InternalSettings &exception);
+
         protected:
 
         //! generate exception group name for given exception index
@@ -0,0 +1,311 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License or (at your option) version 3 or any later version
+ * accepted by the membership of KDE e.V. (or its successor approved
+ * by the membership of KDE e.V.), which shall act as a proxy
+ * defined in Section 14 of version 3 of the license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "breezeexceptionmatcher.h"
+
+#include <QDebug>
+
+namespace Breeze
+{
+
+    //__________________________________________________________________
+    void ExceptionMatcher::clear()
+    {
+        m_patterns.clear();
+        m_exact.clear();
+        m_states.clear();
+        m_firstExpressionIndex = -1;
+        m_standalone.clear();
+        m_combined = QRegularExpression();
+        m_groupIndices.clear();
+    }
+
+    //__________________________________________________________________
+    void ExceptionMatcher::add(int index, const QRegularExpression &pattern)
+    { m_patterns.append({ index, pattern }); }
+
+    //__________________________________________________________________
+    void ExceptionMatcher::compile()
+    {
+        m_exact.clear();
+        m_states = QVector<State>(1);
+        m_firstExpressionIndex = -1;
+        m_standalone.clear();
+        m_combined = QRegularExpression();
+        m_groupIndices.clear();
+
+        // literal patterns, order is kept through their index
+        QList<Pattern> expressions;
+        for (const auto &pattern : std::as_const(m_patterns))
+        {
+            QString literal;
+            switch (literalType(pattern.pattern, literal))
+            {
+                case Exact:
+                if (!m_exact.contains(literal)) m_exact.insert(literal, pattern.index);
+                break;
+
+                case Substring:
+                addSubstring(pattern.index, literal);
+                break;
+
+                case NotLiteral:
+                expressions.append(pattern);
+                if (m_firstExpressionIndex < 0) m_firstExpressionIndex = pattern.index;
+                break;
+            }
+        }
+
+        buildSubstringLinks();
+
+        /*
+        each alternative looks ahead for its pattern anywhere in the string,
+        then captures an empty marker group, whose number identifies the pattern
+        */
+        QString combined;
+        QVector<int> groupIndices(1, -1);
+        for (const auto &pattern : std::as_const(expressions))
+        {
+            if (!canCombine(pattern.pattern))
+            {
+                m_standalone.append(pattern);
+                continue;
+            }
+
+            if (!combined.isEmpty()) combined += QLatin1Char('|');
+            combined += QStringLiteral("(?=[\\s\\S]*?(?:%1))()").arg(pattern.pattern.pattern());
+
+            // groups of the pattern itself, then the marker
+            groupIndices.append(QVector<int>(pattern.pattern.captureCount(), -1));
+            groupIndices.append(pattern.index);
+        }
+
+        if (combined.isEmpty()) return;
+
+        QRegularExpression expression(QStringLiteral("^(?:%1)").arg(combined));
+        if (!expression.isValid())
+        {
+            // e.g. too many patterns, fall back to matching them one by one
+            qWarning() << "Breeze: cannot combine window exception patterns -" << expression.errorString();
+            m_standalone = expressions;
+            return;
+        }
+
+        expression.optimize();
+        m_combined = expression;
+        m_groupIndices = groupIndices;
+    }
+
+    //__________________________________________________________________
+    int ExceptionMatcher::match(const QString &value) const
+    {
+        const int index = matchLiterals(value);
+
+        // regular expressions only matter if one of them comes first
+        if (m_firstExpressionIndex < 0 || (index >= 0 && index < m_firstExpressionIndex)) return index;
+
+        const int expressionIndex = matchExpressions(value, index);
+        return (expressionIndex >= 0 && (index < 0 || expressionIndex < index)) ? expressionIndex : index;
+    }
+
+    //__________________________________________________________________
+    int ExceptionMatcher::matchLiterals(const QString &value) const
+    {
+        int index = -1;
+
+        // like '$', exact patterns also match before a final newline
+        auto exact = m_exact.constFind(value);
+        if (exact == m_exact.constEnd() && value.endsWith(QLatin1Char('\n'))) exact = m_exact.constFind(value.chopped(1));
+        if (exact != m_exact.constEnd()) index = exact.value();
+
+        if (m_states.size() < 2) return index;
+
+        int state = 0;
+        for (const QChar &c : value)
+        {
+            // follow suffix links until a transition exists
+            for (;;)
+            {
+                const auto next = m_states.at(state).next.constFind(c);
+                if (next != m_states.at(state).next.constEnd())
+                {
+                    state = next.value();
+                    break;
+                }
+
+                if (state == 0) break;
+                state = m_states.at(state).fail;
+            }
+
+            const int found = m_states.at(state).index;
+            if (found >= 0 && (index < 0 || found < index)) index = found;
+        }
+
+        return index;
+    }
+
+    //__________________________________________________________________
+    int ExceptionMatcher::matchExpressions(const QString &value, int limit) const
+    {
+        int index = -1;
+        if (!m_combined.pattern().isEmpty())
+        {
+            const auto match = m_combined.match(value);
+            if (match.hasMatch()) index = m_groupIndices.value(match.lastCapturedIndex(), -1);
+        }
+
+        // standalone patterns only matter if they come first
+        if (index >= 0 && (limit < 0 || index < limit)) limit = index;
+        for (const auto &pattern : std::as_const(m_standalone))
+        {
+            if (limit >= 0 && pattern.index > limit) break;
+            if (pattern.pattern.match(value).hasMatch()) return pattern.index;
+        }
+
+        return index;
+    }
+
+    //__________________________________________________________________
+    void ExceptionMatcher::addSubstring(int index, const QString &literal)
+    {
+        int state = 0;
+        for (const QChar &c : literal)
+        {
+            auto next = m_states.at(state).next.constFind(c);
+            if (next != m_states.at(state).next.constEnd()) state = next.value();
+            else
+            {
+                m_states.append(State());
+                const int created = m_states.size() - 1;
+                m_states[state].next.insert(c, created);
+                state = created;
+            }
+        }
+
+        if (m_states.at(state).index < 0) m_states[state].index = index;
+    }
+
+    //__________________________________________________________________
+    void ExceptionMatcher::buildSubstringLinks()
+    {
+        // breadth first, so that suffix states are complete when used
+        QVector<int> queue;
+        for (auto it = m_states.at(0).next.constBegin(); it != m_states.at(0).next.constEnd(); ++it)
+        { queue.append(it.value()); }
+
+        for (int position = 0; position < queue.size(); ++position)
+        {
+            const int state = queue.at(position);
+            const auto transitions = m_states.at(state).next;
+            for (auto it = transitions.constBegin(); it != transitions.constEnd(); ++it)
+            {
+                // longest proper suffix that can be extended with this character
+                int fail = m_states.at(state).fail;
+                for (;;)
+                {
+                    const auto next = m_states.at(fail).next.constFind(it.key());
+                    if (next != m_states.at(fail).next.constEnd() && next.value() != it.value())
+                    {
+                        fail = next.value();
+                        break;
+                    }
+
+                    if (fail == 0) break;
+                    fail = m_states.at(fail).fail;
+                }
+
+                State &child(m_states[it.value()]);
+                child.fail = fail;
+
+                // patterns ending at the suffix also end here
+                const int suffixIndex = m_states.at(fail).index;
+                if (suffixIndex >= 0 && (child.index < 0 || suffixIndex < child.index)) child.index = suffixIndex;
+
+                queue.append(it.value());
+            }
+        }
+    }
+
+    //__________________________________________________________________
+    ExceptionMatcher::LiteralType ExceptionMatcher::literalType(const QRegularExpression &pattern, QString &literal)
+    {
+        if (pattern.patternOptions() != QRegularExpression::NoPatternOption) return NotLiteral;
+
+        QString text(pattern.pattern());
+        bool anchoredStart = false;
+        bool anchoredEnd = false;
+        if (text.startsWith(QLatin1Char('^')))
+        {
+            anchoredStart = true;
+            text.remove(0, 1);
+        }
+
+        // a final '$' is an anchor, unless escaped
+        if (text.endsWith(QLatin1Char('$')))
+        {
+            int backslashes = 0;
+            for (int i = text.size() - 2; i >= 0 && text.at(i) == QLatin1Char('\\'); --i) ++backslashes;
+            if (backslashes % 2 == 0)
+            {
+                anchoredEnd = true;
+                text.chop(1);
+            }
+        }
+
+        // only prefix or only suffix anchors are left to the regular expression engine
+        if (anchoredStart != anchoredEnd) return NotLiteral;
+
+        static const QString metaCharacters(QStringLiteral("\\^$.|?*+()[]{}"));
+        literal.clear();
+        for (int i = 0; i < text.size(); ++i)
+        {
+            const QChar c(text.at(i));
+            if (c == QLatin1Char('\\'))
+            {
+                // escaped punctuation is literal, other escapes are classes or assertions
+                if (i + 1 >= text.size()) return NotLiteral;
+                const QChar escaped(text.at(i + 1));
+                if (escaped.isLetterOrNumber() || escaped.unicode() > 127 || escaped.isSpace()) return NotLiteral;
+                literal += escaped;
+                ++i;
+            }
+            else if (metaCharacters.contains(c)) return NotLiteral;
+            else literal += c;
+        }
+
+        if (anchoredStart) return Exact;
+        return literal.isEmpty() ? NotLiteral : Substring;
+    }
+
+    //__________________________________________________________________
+    bool ExceptionMatcher::canCombine(const QRegularExpression &pattern)
+    {
+        /*
+        back references, named groups, recursion and subroutine calls depend on group numbering and names,
+        quoting, verbs and extended syntax comments may escape the enclosing group
+        */
+        static const QRegularExpression unsafe(QStringLiteral(
+            "\\\\[1-9gkQ]|\\(\\?P|\\(\\?<[a-zA-Z_]|\\(\\?'|\\(\\?\\||\\(\\?\\(|\\(\\*|\\(\\?[a-zA-Z-]*x"
+            "|\\(\\?R\\)|\\(\\?[+-]?[0-9]|\\(\\?&"));
+
+        return pattern.patternOptions() == QRegularExpression::NoPatternOption
+            && !unsafe.match(pattern.pattern()).hasMatch();
+    }
+
+}
@@ -0,0 +1,131 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License or (at your option) version 3 or any later version
+ * accepted by the membership of KDE e.V. (or its successor approved
+ * by the membership of KDE e.V.), which shall act as a proxy
+ * defined in Section 14 of version 3 of the license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+#include <QHash>
+#include <QList>
+#include <QRegularExpression>
+#include <QVector>
+
+namespace Breeze
+{
+
+    //* finds the first of an ordered list of patterns matching a string
+    /**
+    patterns without regular expression syntax are classified when compiled: exact matches
+    (^literal$) go to a hash, other literals to an Aho-Corasick automaton finding all of them
+    in one pass over the string.
+
+    Remaining patterns are merged into a single regular expression, whose alternatives are tried
+    in order at the start of the string, each one looking ahead for its pattern. The first
+    alternative that succeeds is the lowest matching index. This saves one match call per
+    pattern, but each failing lookahead still scans the string: only literal patterns are
+    matched in a single pass. Patterns that cannot be safely embedded, e.g. using back references
+    or subroutine calls, are matched on their own
+    */
+    class ExceptionMatcher
+    {
+
+        public:
+
+        //* remove all patterns
+        void clear();
+
+        //* add a valid pattern, with its index. Indices must be increasing
+        void add(int index, const QRegularExpression &pattern);
+
+        //* build the combined expression, once all patterns are added
+        void compile();
+
+        //* true if there is no pattern
+        bool isEmpty() const
+        { return m_patterns.isEmpty(); }
+
+        //* lowest index of the patterns matching given value, -1 if none
+        int match(const QString &value) const;
+
+        private:
+
+        //* true if pattern can be embedded in the combined expression
+        static bool canCombine(const QRegularExpression &pattern);
+
+        //* literal patterns
+        enum LiteralType
+        {
+            NotLiteral,
+            Substring,
+            Exact
+        };
+
+        //* classify pattern, and store its unescaped text in literal
+        static LiteralType literalType(const QRegularExpression &pattern, QString &literal);
+
+        //* add substring pattern to the automaton
+        void addSubstring(int index, const QString &literal);
+
+        //* link automaton states to their longest proper suffix
+        void buildSubstringLinks();
+
+        //* lowest index of the literal patterns matching value, -1 if none
+        int matchLiterals(const QString &value) const;
+
+        //* lowest index of the regular expressions matching value, -1 if none. Indices above limit are not needed
+        int matchExpressions(const QString &value, int limit) const;
+
+        struct Pattern
+        {
+            int index;
+            QRegularExpression pattern;
+        };
+
+        //* all patterns
+        QList<Pattern> m_patterns;
+
+        //* exact patterns, by text
+        QHash<QString, int> m_exact;
+
+        //* Aho-Corasick automaton state
+        struct State
+        {
+            QHash<QChar, int> next;
+            int fail = 0;
+
+            //* lowest index of the patterns ending here, including through suffix links
+            int index = -1;
+        };
+
+        //* automaton, the first state is the root
+        QVector<State> m_states;
+
+        //* lowest index of all regular expressions, -1 if none
+        int m_firstExpressionIndex = -1;
+
+        //* patterns matched on their own
+        QList<Pattern> m_standalone;
+
+        //* combined expression
+        QRegularExpression m_combined;
+
+        //* index of the pattern, for each capture group of the combined expression
+        QVector<int> m_groupIndices;
+
+    };
+
+}
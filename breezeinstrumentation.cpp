@@ -0,0 +1,101 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License or (at your option) version 3 or any later version
+ * accepted by the membership of KDE e.V. (or its successor approved
+ * by the membership of KDE e.V.), which shall act as a proxy
+ * defined in Section 14 of version 3 of the license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "breezeinstrumentation.h"
+
+#include <QCoreApplication>
+#include <QTimer>
+
+#include <atomic>
+
+Q_LOGGING_CATEGORY(BREEZE_INSTRUMENTATION, "breeze.decoration.instrumentation", QtWarningMsg)
+
+namespace Breeze
+{
+
+    namespace Instrumentation
+    {
+
+        //__________________________________________________________________
+        static std::atomic<quint64> s_counters[CounterCount];
+
+        //* interval between periodic reports (ms)
+        static constexpr int ReportInterval = 60000;
+
+        //__________________________________________________________________
+        static const char *counterName(Counter counter)
+        {
+            switch (counter)
+            {
+                case BlurRegionUpdatesSkipped: return "blur region updates skipped";
+                case ButtonImageHits: return "shared button images reused";
+                case ButtonImageMisses: return "shared button images rendered";
+                case ButtonImageBytes: return "shared button images memory (bytes)";
+                default: return "unknown";
+            }
+        }
+
+        //__________________________________________________________________
+        void count(Counter counter, quint64 amount)
+        { s_counters[counter].fetch_add(amount, std::memory_order_relaxed); }
+
+        //__________________________________________________________________
+        void set(Counter counter, quint64 value)
+        { s_counters[counter].store(value, std::memory_order_relaxed); }
+
+        //__________________________________________________________________
+        quint64 value(Counter counter)
+        { return s_counters[counter].load(std::memory_order_relaxed); }
+
+        //__________________________________________________________________
+        void report()
+        {
+            if (!BREEZE_INSTRUMENTATION().isDebugEnabled()) return;
+
+            for (int index = 0; index < CounterCount; ++index)
+            {
+                const auto counter = static_cast<Counter>(index);
+                qCDebug(BREEZE_INSTRUMENTATION) << counterName(counter) << value(counter);
+            }
+
+            const quint64 lookups = value(ButtonImageHits) + value(ButtonImageMisses);
+            if (lookups > 0)
+            { qCDebug(BREEZE_INSTRUMENTATION) << "shared button images hit rate" << qreal(value(ButtonImageHits))/lookups; }
+        }
+
+        //__________________________________________________________________
+        void startReporting()
+        {
+            static bool started = false;
+            if (started || !BREEZE_INSTRUMENTATION().isDebugEnabled()) return;
+
+            // decorations live as long as their windows, so reports cannot wait for the last one to go.
+            // The timer belongs to the application, and is deleted before static destruction
+            auto application = QCoreApplication::instance();
+            if (!application) return;
+
+            started = true;
+            auto timer = new QTimer(application);
+            timer->setInterval(ReportInterval);
+            QObject::connect(timer, &QTimer::timeout, application, &report);
+            timer->start();
+        }
+
+    }
+
+}
@@ -0,0 +1,56 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License or (at your option) version 3 or any later version
+ * accepted by the membership of KDE e.V. (or its successor approved
+ * by the membership of KDE e.V.), which shall act as a proxy
+ * defined in Section 14 of version 3 of the license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QLoggingCategory>
+
+Q_DECLARE_LOGGING_CATEGORY(BREEZE_INSTRUMENTATION)
+
+namespace Breeze
+{
+
+    //* process wide counters, reported with the "breeze.decoration.instrumentation" logging category
+    namespace Instrumentation
+    {
+        enum Counter
+        {
+            BlurRegionUpdatesSkipped,
+            ButtonImageHits,
+            ButtonImageMisses,
+            ButtonImageBytes,
+            CounterCount
+        };
+
+        //* increment counter
+        void count(Counter counter, quint64 amount = 1);
+
+        //* set counter, for gauges such as memory use
+        void set(Counter counter, quint64 value);
+
+        //* counter value
+        quint64 value(Counter counter);
+
+        //* log all counters
+        void report();
+
+        //* log all counters periodically, if the logging category is enabled. Does nothing if already started
+        void startReporting();
+    }
+
+}
@@ -0,0 +1,146 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License or (at your option) version 3 or any later version
+ * accepted by the membership of KDE e.V. (or its successor approved
+ * by the membership of KDE e.V.), which shall act as a proxy
+ * defined in Section 14 of version 3 of the license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "breezesettingscache.h"
+
+#include <QCryptographicHash>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+namespace Breeze
+{
+
+    namespace SettingsCache
+    {
+
+        //* file identification
+        static constexpr quint32 Magic = 0x42524543;
+
+        //* format version, to be increased whenever the format or the default settings change
+        static constexpr quint32 Version = 1;
+
+        //* stream version
+        static constexpr int StreamVersion = QDataStream::Qt_6_0;
+
+        //* sanity limit, for broken files
+        static constexpr quint32 MaxExceptions = 1<<16;
+
+        //__________________________________________________________________
+        static QString fileName()
+        {
+            return QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation)
+                + QStringLiteral("/breezeenhanced/settings.cache");
+        }
+
+        //__________________________________________________________________
+        QByteArray configurationHash()
+        {
+            // all files KConfig reads for breezerc, including the look and feel defaults
+            QStringList files(QStandardPaths::locateAll(QStandardPaths::GenericConfigLocation, QStringLiteral("breezerc")));
+            files.append(QStandardPaths::writableLocation(QStandardPaths::GenericConfigLocation) + QStringLiteral("/kdedefaults/breezerc"));
+
+            // a new build may change the defaults or the cached settings
+            QCryptographicHash hash(QCryptographicHash::Sha1);
+            hash.addData(QByteArrayLiteral(BREEZE_BUILD_ID));
+
+            for (const QString &path : std::as_const(files))
+            {
+                QFile file(path);
+                if (!file.open(QIODevice::ReadOnly)) continue;
+
+                hash.addData(path.toUtf8());
+                hash.addData(&file);
+            }
+
+            return hash.result();
+        }
+
+        //__________________________________________________________________
+        bool read(const QByteArray &hash, SettingsSnapshot &defaults, QList<ExceptionOverlay> &exceptions)
+        {
+            QFile file(fileName());
+            if (!file.open(QIODevice::ReadOnly)) return false;
+
+            // the file is mapped rather than read, and unmapped when closed
+            const qint64 size = file.size();
+            const uchar *data = size > 0 ? file.map(0, size) : nullptr;
+            if (!data) return false;
+
+            const QByteArray bytes(QByteArray::fromRawData(reinterpret_cast<const char *>(data), size));
+            QDataStream stream(bytes);
+            stream.setVersion(StreamVersion);
+
+            quint32 magic = 0;
+            quint32 version = 0;
+            QByteArray cachedHash;
+            stream >> magic >> version >> cachedHash;
+            if (stream.status() != QDataStream::Ok || magic != Magic || version != Version || cachedHash != hash) return false;
+
+            SettingsSnapshot cachedDefaults;
+            quint32 count = 0;
+            stream >> cachedDefaults >> count;
+            if (stream.status() != QDataStream::Ok || count > MaxExceptions) return false;
+
+            QList<ExceptionOverlay> cachedExceptions;
+            cachedExceptions.reserve(count);
+            for (quint32 index = 0; index < count; ++index)
+            {
+                ExceptionOverlay exception;
+                stream >> exception;
+                cachedExceptions.append(exception);
+            }
+
+            if (stream.status() != QDataStream::Ok || !stream.atEnd())
+            {
+                qWarning() << "Breeze: ignoring broken settings cache" << file.fileName();
+                return false;
+            }
+
+            defaults = cachedDefaults;
+            exceptions = cachedExceptions;
+            return true;
+        }
+
+        //__________________________________________________________________
+        void write(const QByteArray &hash, const SettingsSnapshot &defaults, const QList<ExceptionOverlay> &exceptions)
+        {
+            const QString name(fileName());
+            QDir().mkpath(QFileInfo(name).absolutePath());
+
+            // readers never see a partially written file
+            QSaveFile file(name);
+            if (!file.open(QIODevice::WriteOnly)) return;
+
+            QDataStream stream(&file);
+            stream.setVersion(StreamVersion);
+            stream << Magic << Version << hash << defaults << quint32(exceptions.size());
+            for (const ExceptionOverlay &exception : exceptions)
+            { stream << exception; }
+
+            if (stream.status() != QDataStream::Ok || !file.commit())
+            { qWarning() << "Breeze: cannot write settings cache" << name; }
+        }
+
+    }
+
+}
@@ -0,0 +1,50 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License or (at your option) version 3 or any later version
+ * accepted by the membership of KDE e.V. (or its successor approved
+ * by the membership of KDE e.V.), which shall act as a proxy
+ * defined in Section 14 of version 3 of the license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "breezesettingssnapshot.h"
+
+#include <QByteArray>
+#include <QList>
+
+namespace Breeze
+{
+
+    //* compiled settings, saved to a binary file so that startup does not parse the configuration
+    /**
+    the file holds the default settings and the enabled exceptions with valid patterns,
+    together with a hash of the configuration files it was built from. It is only used
+    while that hash matches, and rewritten whenever the configuration is parsed.
+    A missing or broken file is never an error, the configuration is just parsed
+    */
+    namespace SettingsCache
+    {
+
+        //* hash of the configuration files and of the build, which a usable cache must match
+        QByteArray configurationHash();
+
+        //* read cache built from configuration with given hash. Returns false if there is no such cache
+        bool read(const QByteArray &hash, SettingsSnapshot &defaults, QList<ExceptionOverlay> &exceptions);
+
+        //* write cache for configuration with given hash
+        void write(const QByteArray &hash, const SettingsSnapshot &defaults, const QList<ExceptionOverlay> &exceptions);
+
+    }
+
+}
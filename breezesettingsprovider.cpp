@@ -20,112 +20,224 @@
 
 #include "breezesettingsprovider.h"
 
+#include "breezebuttonatlas.h"
 #include "breezeexceptionlist.h"
+#include "breezeinstrumentation.h"
+#include "breezesettingscache.h"
 
 //#include <KWindowInfo>
 
+#include <QDebug>
+#include <QHash>
 #include <QRegularExpression>
 #include <QTextStream>
 
 namespace Breeze
 {
 
-    SettingsProvider *SettingsProvider::s_self = nullptr;
-
     //__________________________________________________________________
-    SettingsProvider::SettingsProvider():
-        m_config( KSharedConfig::openConfig( QStringLiteral("breezerc") ) )
-    { reconfigure(); }
+    SettingsProvider::SettingsProvider()
+    {
+        m_reconfigureTimer = new QTimer(this);
+        m_reconfigureTimer->setSingleShot(true);
+        m_reconfigureTimer->setInterval(ReconfigureDelay);
+        connect(m_reconfigureTimer, &QTimer::timeout, this, &SettingsProvider::reconfigure);
 
-    //__________________________________________________________________
-    SettingsProvider::~SettingsProvider()
-    { s_self = nullptr; }
+        reconfigure();
+    }
 
     //__________________________________________________________________
     SettingsProvider *SettingsProvider::self()
     {
-        // TODO: this is not thread safe!
-        if (!s_self)
-        { s_self = new SettingsProvider(); }
-
+        // initialized once, even if first used concurrently. Kept until the plugin is unloaded
+        static SettingsProvider *const s_self = new SettingsProvider();
         return s_self;
     }
 
+    //__________________________________________________________________
+    void SettingsProvider::scheduleReconfigure()
+    {
+        // restarting the timer merges consecutive requests
+        m_reconfigureTimer->start();
+    }
+
     //__________________________________________________________________
     void SettingsProvider::reconfigure()
     {
-        if( !m_defaultSettings )
+        m_reconfigureTimer->stop();
+
+        // nothing to do if the configuration files did not change
+        const QByteArray hash(SettingsCache::configurationHash());
+        if (hash == m_configurationHash) return;
+        m_configurationHash = hash;
+
+        // the configuration is only parsed if it changed since the cache was written
+        SettingsSnapshot defaults;
+        QList<ExceptionOverlay> overlays;
+        QList<QRegularExpression> patterns;
+        if (SettingsCache::read(hash, defaults, overlays))
+        {
+            for (const ExceptionOverlay &overlay : std::as_const(overlays))
+            { patterns.append(QRegularExpression(overlay.pattern)); }
+        }
+        else
         {
-            m_defaultSettings = InternalSettingsPtr(new InternalSettings());
-            m_defaultSettings->setCurrentGroup( QStringLiteral("Windeco") );
+            readConfiguration(defaults, overlays, patterns);
+            SettingsCache::write(hash, defaults, overlays);
         }
 
-        m_defaultSettings->load();
+        auto generation = std::make_shared<Generation>();
+        generation->serial = ++m_serial;
+        generation->defaultSnapshot = QSharedPointer<SettingsSnapshot>::create(defaults);
 
-        ExceptionList exceptions;
-        exceptions.readConfig( m_config );
-        m_exceptions = exceptions.get();
+        for (int index = 0; index < overlays.size(); ++index)
+        {
+            const ExceptionOverlay &overlay(overlays.at(index));
+
+            // the defaults, with the settings overridden by the exception
+            auto snapshot = QSharedPointer<SettingsSnapshot>::create(defaults);
+            overlay.apply(*snapshot);
+
+            // patterns are compiled and optimized here rather than when first matched, while painting
+            QRegularExpression pattern(patterns.at(index));
+            pattern.optimize();
+
+            generation->exceptions.append({ overlay, pattern, snapshot });
+        }
+
+        // one combined matcher per exception type
+        for (int index = 0; index < generation->exceptions.size(); ++index)
+        {
+            const Exception &exception(generation->exceptions.at(index));
+            if (exception.overlay.type == InternalSettings::ExceptionWindowTitle)
+            {
+                generation->titleMatcher.add(index, exception.pattern);
+                if (generation->firstTitleIndex < 0) generation->firstTitleIndex = index;
+            }
+            else generation->classMatcher.add(index, exception.pattern);
+        }
+
+        generation->titleMatcher.compile();
+        generation->classMatcher.compile();
+
+        // nothing to do if no setting changed, the current generation also keeps its caches
+        const auto current = this->generation();
+        if (current
+            && *generation->defaultSnapshot == *current->defaultSnapshot
+            && generation->exceptions == current->exceptions)
+        { return; }
+
+        // publish
+        QT_WARNING_PUSH
+        QT_WARNING_DISABLE_DEPRECATED
+        std::atomic_store(&m_generation, std::shared_ptr<const Generation>(std::move(generation)));
+        QT_WARNING_POP
+
+        // drop button images of the previous configuration
+        ButtonAtlas::self().clear();
+
+        // decorations find out themselves which of their settings changed
+        if (current) Q_EMIT reconfigured();
+
+        // counters of the previous configuration
+        Instrumentation::report();
 
     }
 
     //__________________________________________________________________
-    InternalSettingsPtr SettingsProvider::internalSettings(Decoration *decoration) const
+    void SettingsProvider::readConfiguration(SettingsSnapshot &defaults, QList<ExceptionOverlay> &exceptions, QList<QRegularExpression> &patterns)
     {
+        if (!m_config)
+        { m_config = KSharedConfig::openConfig( QStringLiteral("breezerc") ); }
+
+        InternalSettings defaultSettings;
+        defaultSettings.setCurrentGroup( QStringLiteral("Windeco") );
+        defaultSettings.load();
+        defaults = SettingsSnapshot(defaultSettings);
+
+        /*
+        only the settings overridden by exceptions are kept, rather than loading
+        the complete configuration once per exception
+        */
+        exceptions.clear();
+        patterns.clear();
+        InternalSettings internalSettings;
+        for (int index = 0; ExceptionList::readException(m_config, index, internalSettings); ++index)
+        {
+            // discard disabled exceptions
+            if (!internalSettings.enabled()) continue;
 
-        QString windowTitle;
-        QString windowClass;
+            // discard exceptions with empty exception pattern
+            if (internalSettings.exceptionPattern().isEmpty()) continue;
+
+            const QRegularExpression pattern(internalSettings.exceptionPattern());
+            if (!pattern.isValid())
+            {
+                qWarning() << "Breeze: ignoring window exception with invalid pattern" << pattern.pattern() << "-" << pattern.errorString();
+                continue;
+            }
+
+            // the pattern compiled for validation is kept
+            exceptions.append(ExceptionOverlay(internalSettings));
+            patterns.append(pattern);
+        }
+    }
+
+    //__________________________________________________________________
+    SettingsSnapshotPtr SettingsProvider::settingsSnapshot(Decoration *decoration) const
+    {
 
         // get the decorated window
         const auto w = decoration->window();
 
-        for (auto internalSettings : std::as_const(m_exceptions))
+        // the same generation is used throughout, even if a new one is published meanwhile
+        const auto generation = this->generation();
+
+        // the first matching exception wins, whatever its type
+        int index = generation->classMatcher.isEmpty() ? -1 : generation->classIndex(w->windowClass());
+
+        // titles change, so they are always matched, unless a class exception comes first
+        if (!generation->titleMatcher.isEmpty() && (index < 0 || index > generation->firstTitleIndex))
         {
-            // discard disabled exceptions
-            if (!internalSettings->enabled()) continue;
+            const int titleIndex = generation->titleMatcher.match(w->caption());
+            if (titleIndex >= 0 && (index < 0 || titleIndex < index)) index = titleIndex;
+        }
 
-            // discard exceptions with empty exception pattern
-            if (internalSettings->exceptionPattern().isEmpty()) continue;
+        return index < 0 ? generation->defaultSnapshot : generation->exceptions.at(index).snapshot;
 
-            /*if (internalSettings->isDialog())
-            {
-                KWindowInfo info(w->windowId(), NET::WMWindowType);
-                if (info.valid()
-                    && info.windowType(NET::NormalMask | NET::DialogMask) != NET::Dialog) {
-                    continue;
-                }
-            }*/
-
-            /*
-            decide which value is to be compared
-            to the regular expression, based on exception type
-            */
-            QString value;
-            switch (internalSettings->exceptionType())
-            {
-                case InternalSettings::ExceptionWindowTitle:
-                {
-                    value = windowTitle.isEmpty() ? (windowTitle = w->caption()):windowTitle;
-                    break;
-                }
-
-                default:
-                case InternalSettings::ExceptionWindowClassName: {
-                    value = windowClass.isEmpty() ? (windowClass = w->windowClass()) : windowClass;
-                    break;
-                }
+    }
 
-            }
+    //__________________________________________________________________
+    std::shared_ptr<const SettingsProvider::Generation> SettingsProvider::generation() const
+    {
+        // the free functions rather than std::atomic<std::shared_ptr>, which not all standard libraries provide
+        QT_WARNING_PUSH
+        QT_WARNING_DISABLE_DEPRECATED
+        return std::atomic_load(&m_generation);
+        QT_WARNING_POP
+    }
 
-            // check matching
-            QRegularExpression rx( internalSettings->exceptionPattern() );
-            if (rx.match(value).hasMatch())
-            {
-                return internalSettings;
-            }
+    //__________________________________________________________________
+    int SettingsProvider::Generation::classIndex(const QString &windowClass) const
+    {
+        // per thread, so that lookups take no lock. Dropped when another generation is used
+        thread_local quint64 cachedSerial = 0;
+        thread_local QHash<QString, int> classIndices;
+        if (cachedSerial != serial)
+        {
+            classIndices.clear();
+            cachedSerial = serial;
         }
 
-        return m_defaultSettings;
+        auto it = classIndices.constFind(windowClass);
+        if (it != classIndices.constEnd()) return it.value();
+
+        const int index = classMatcher.match(windowClass);
 
+        // window classes are few, but do not let unusual clients grow the cache forever
+        if (classIndices.size() >= MaxClassIndices) classIndices.clear();
+        classIndices.insert(windowClass, index);
+        return index;
     }
 
 }
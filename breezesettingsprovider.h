@@ -23,11 +23,17 @@
 
 #include "breeze.h"
 #include "breezedecoration.h"
+#include "breezeexceptionmatcher.h"
 #include "breezesettings.h"
+#include "breezesettingssnapshot.h"
 
 #include <KSharedConfig>
 
 #include <QObject>
+#include <QRegularExpression>
+#include <QTimer>
+
+#include <memory>
 
 namespace Breeze
 {
@@ -39,38 +45,106 @@ namespace Breeze
 
         public:
 
-        //* destructor
-        ~SettingsProvider();
-
-        //* singleton
+        //* singleton, created on first use from any thread
         static SettingsProvider *self();
 
-        //* internal settings for given decoration
-        InternalSettingsPtr internalSettings(Decoration *) const;
+        //* effective settings for given decoration
+        SettingsSnapshotPtr settingsSnapshot(Decoration *) const;
+
+        //* true if some enabled exception matches window titles, which decorations then follow
+        bool hasTitleExceptions() const
+        { return !generation()->titleMatcher.isEmpty(); }
+
+        Q_SIGNALS:
+
+        //* emitted when a reload changed the settings of some windows, which decorations then compare to theirs
+        void reconfigured();
 
         public Q_SLOTS:
 
-        //* reconfigure
+        //* reload the configuration after a short delay, so that bursts of changes are read once
+        void scheduleReconfigure();
+
+        //* reload the configuration now
         void reconfigure();
 
         private:
 
+        //* delay before a scheduled reload (ms)
+        static constexpr int ReconfigureDelay = 100;
+
+        //* scheduled reload
+        QTimer *m_reconfigureTimer = nullptr;
+
         //* constructor
         SettingsProvider();
 
-        //* default configuration
-        InternalSettingsPtr m_defaultSettings;
+        //* read default settings and enabled exceptions with valid patterns from the configuration, along with their compiled patterns
+        void readConfiguration(SettingsSnapshot &defaults, QList<ExceptionOverlay> &exceptions, QList<QRegularExpression> &patterns);
 
-        //* exceptions
-        InternalSettingsList m_exceptions;
+        //* enabled exception with its pattern
+        struct Exception
+        {
+            ExceptionOverlay overlay;
+            QRegularExpression pattern;
 
-        //* config object
-        KSharedConfigPtr m_config;
+            //* effective settings, the defaults with the overridden settings
+            SettingsSnapshotPtr snapshot;
+
+            //* equality, ignoring the effective settings
+            bool operator==(const Exception &other) const
+            { return overlay == other.overlay; }
+        };
+
+        //* complete configuration, never modified once published
+        /**
+        reconfigure() builds a new generation and swaps it in, so readers of any thread see either
+        the previous or the new rule set, never a partial one, and keep using the one they loaded
+        for as long as they need. The pointer is swapped atomically and exception snapshots are
+        built with the generation, so that readers never take a lock
+        */
+        struct Generation
+        {
+            //* effective settings of windows without exception
+            SettingsSnapshotPtr defaultSnapshot;
+
+            //* enabled exceptions with valid patterns, in order
+            QList<Exception> exceptions;
 
-        //* singleton
-        static SettingsProvider *s_self;
+            //*@name index of the first matching exception, per exception type
+            //@{
+            ExceptionMatcher titleMatcher;
+            ExceptionMatcher classMatcher;
+            //@}
+
+            //* index of the first window title exception, -1 if none
+            int firstTitleIndex = -1;
+
+            //* index of the first class exception matching windowClass, -1 if none. Cached per thread
+            int classIndex(const QString &windowClass) const;
+
+            //* identifies the generation in the per thread caches
+            quint64 serial = 0;
+        };
+
+        //* maximum number of cached window classes
+        static constexpr int MaxClassIndices = 256;
+
+        //* current generation
+        std::shared_ptr<const Generation> generation() const;
+
+        //* current generation, only accessed with std::atomic_load and std::atomic_store
+        std::shared_ptr<const Generation> m_generation;
+
+        //* serial of the last built generation
+        quint64 m_serial = 0;
+
+        //* hash of the configuration files the current generation was built from
+        QByteArray m_configurationHash;
+
+        //* config object, only opened if the settings cache cannot be used
+        KSharedConfigPtr m_config;
 
     };
 
 }
-
@@ -0,0 +1,215 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License or (at your option) version 3 or any later version
+ * accepted by the membership of KDE e.V. (or its successor approved
+ * by the membership of KDE e.V.), which shall act as a proxy
+ * defined in Section 14 of version 3 of the license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "breezesettingssnapshot.h"
+
+#include <QFontDatabase>
+
+namespace Breeze
+{
+
+    //__________________________________________________________________
+    SettingsSnapshot::SettingsSnapshot(const InternalSettings &settings):
+        shadowSize(settings.shadowSize()),
+        shadowStrength(settings.shadowStrength()),
+        shadowColor(settings.shadowColor()),
+        mask(settings.mask()),
+        borderSize(settings.borderSize()),
+        titleAlignment(settings.titleAlignment()),
+        extraTitleMargin(settings.extraTitleMargin()),
+        captionRepaintInterval(settings.captionRepaintInterval()),
+        hideTitleBar(settings.hideTitleBar()),
+        opaqueTitleBar(settings.opaqueTitleBar()),
+        flatTitleBar(settings.flatTitleBar()),
+        opacityOverride(settings.opacityOverride()),
+        backgroundOpacity(settings.backgroundOpacity()),
+        drawBackgroundGradient(settings.drawBackgroundGradient()),
+        backgroundGradientIntensity(settings.backgroundGradientIntensity()),
+        titleBarFontString(settings.titleBarFont()),
+        buttonSize(settings.buttonSize()),
+        buttonStyle(settings.buttonStyle()),
+        buttonSpacing(settings.buttonSpacing()),
+        macOSButtons(settings.macOSButtons()),
+        animationsEnabled(settings.animationsEnabled()),
+        animationsDuration(settings.animationsDuration()),
+        animationFrames(settings.animationFrames())
+    { updateDerived(); }
+
+    //__________________________________________________________________
+    void SettingsSnapshot::updateDerived()
+    {
+        if (opaqueTitleBar) titleBarAlpha = 255;
+        else
+        {
+            const int opacity = qBound(0, opacityOverride > -1 ? opacityOverride : backgroundOpacity, 100);
+            titleBarAlpha = qRound(static_cast<qreal>(opacity) * static_cast<qreal>(2.55));
+        }
+
+        // the gradient is only drawn on non flat title bars
+        const bool gradient = drawBackgroundGradient && !flatTitleBar;
+        gradientLightFactor = 130 + (gradient ? backgroundGradientIntensity : 0);
+        gradientFactor = 100 + (gradient ? backgroundGradientIntensity : 0);
+
+        // without configured font, the application font is resolved when used, so that it follows system changes
+        configuredTitleBarFont = QFont();
+        configuredCaptionFont = QFont();
+        if (titleBarFontString.isEmpty()) return;
+
+        configuredTitleBarFont.fromString(titleBarFontString);
+
+        // KDE needs this FIXME: Why?
+        configuredCaptionFont = configuredTitleBarFont;
+        configuredCaptionFont.setStyleName(QFontDatabase::styleString(configuredCaptionFont));
+    }
+
+    //__________________________________________________________________
+    QFont SettingsSnapshot::titleBarFont() const
+    { return titleBarFontString.isEmpty() ? QFont() : configuredTitleBarFont; }
+
+    //__________________________________________________________________
+    QFont SettingsSnapshot::captionFont() const
+    {
+        if (!titleBarFontString.isEmpty()) return configuredCaptionFont;
+
+        QFont font;
+        font.setStyleName(QFontDatabase::styleString(font));
+        return font;
+    }
+
+    //__________________________________________________________________
+    int SettingsSnapshot::changes(const SettingsSnapshot &other) const
+    {
+        int changes = 0;
+
+        if (shadowSize != other.shadowSize
+            || shadowStrength != other.shadowStrength
+            || shadowColor != other.shadowColor)
+        { changes |= ShadowChange; }
+
+        // the top border follows the font and button heights
+        if (mask != other.mask
+            || borderSize != other.borderSize
+            || titleBarFontString != other.titleBarFontString
+            || buttonSize != other.buttonSize)
+        { changes |= BorderChange; }
+
+        if (buttonSize != other.buttonSize
+            || buttonStyle != other.buttonStyle
+            || buttonSpacing != other.buttonSpacing
+            || macOSButtons != other.macOSButtons
+            || animationsEnabled != other.animationsEnabled
+            || animationsDuration != other.animationsDuration
+            || animationFrames != other.animationFrames)
+        { changes |= ButtonChange; }
+
+        if (titleAlignment != other.titleAlignment
+            || extraTitleMargin != other.extraTitleMargin
+            || titleBarAlpha != other.titleBarAlpha
+            || gradientLightFactor != other.gradientLightFactor
+            || gradientFactor != other.gradientFactor
+            || flatTitleBar != other.flatTitleBar
+            || titleBarFontString != other.titleBarFontString)
+        { changes |= TitleBarChange; }
+
+        // hiding the title bar changes about everything
+        if (hideTitleBar != other.hideTitleBar)
+        { changes |= BorderChange|ButtonChange|TitleBarChange; }
+
+        return changes;
+    }
+
+    //__________________________________________________________________
+    ExceptionOverlay::ExceptionOverlay(const InternalSettings &settings):
+        pattern(settings.exceptionPattern()),
+        type(settings.exceptionType()),
+        mask(settings.mask()),
+        borderSize(settings.borderSize()),
+        hideTitleBar(settings.hideTitleBar()),
+        opaqueTitleBar(settings.opaqueTitleBar()),
+        opacityOverride(settings.opacityOverride()),
+        flatTitleBar(settings.flatTitleBar())
+    {}
+
+    //__________________________________________________________________
+    void ExceptionOverlay::apply(SettingsSnapshot &snapshot) const
+    {
+        snapshot.mask = mask;
+
+        // propagate all features found in mask to the output configuration
+        if (mask & BorderSize)
+            snapshot.borderSize = borderSize;
+        snapshot.hideTitleBar = hideTitleBar;
+        snapshot.opaqueTitleBar = opaqueTitleBar;
+        snapshot.opacityOverride = opacityOverride;
+        snapshot.flatTitleBar = flatTitleBar;
+        snapshot.updateDerived();
+    }
+
+    //__________________________________________________________________
+    QDataStream &operator<<(QDataStream &stream, const SettingsSnapshot &snapshot)
+    {
+        return stream
+            << snapshot.shadowSize << snapshot.shadowStrength << snapshot.shadowColor
+            << snapshot.mask << snapshot.borderSize
+            << snapshot.titleAlignment << snapshot.extraTitleMargin << snapshot.captionRepaintInterval
+            << snapshot.hideTitleBar << snapshot.opaqueTitleBar << snapshot.flatTitleBar
+            << snapshot.opacityOverride << snapshot.backgroundOpacity
+            << snapshot.drawBackgroundGradient << snapshot.backgroundGradientIntensity << snapshot.titleBarFontString
+            << snapshot.buttonSize << snapshot.buttonStyle << snapshot.buttonSpacing << snapshot.macOSButtons
+            << snapshot.animationsEnabled << snapshot.animationsDuration << snapshot.animationFrames;
+    }
+
+    //__________________________________________________________________
+    QDataStream &operator>>(QDataStream &stream, SettingsSnapshot &snapshot)
+    {
+        stream
+            >> snapshot.shadowSize >> snapshot.shadowStrength >> snapshot.shadowColor
+            >> snapshot.mask >> snapshot.borderSize
+            >> snapshot.titleAlignment >> snapshot.extraTitleMargin >> snapshot.captionRepaintInterval
+            >> snapshot.hideTitleBar >> snapshot.opaqueTitleBar >> snapshot.flatTitleBar
+            >> snapshot.opacityOverride >> snapshot.backgroundOpacity
+            >> snapshot.drawBackgroundGradient >> snapshot.backgroundGradientIntensity >> snapshot.titleBarFontString
+            >> snapshot.buttonSize >> snapshot.buttonStyle >> snapshot.buttonSpacing >> snapshot.macOSButtons
+            >> snapshot.animationsEnabled >> snapshot.animationsDuration >> snapshot.animationFrames;
+
+        snapshot.updateDerived();
+        return stream;
+    }
+
+    //__________________________________________________________________
+    QDataStream &operator<<(QDataStream &stream, const ExceptionOverlay &exception)
+    {
+        return stream
+            << exception.pattern << exception.type
+            << exception.mask << exception.borderSize
+            << exception.hideTitleBar << exception.opaqueTitleBar
+            << exception.opacityOverride << exception.flatTitleBar;
+    }
+
+    //__________________________________________________________________
+    QDataStream &operator>>(QDataStream &stream, ExceptionOverlay &exception)
+    {
+        return stream
+            >> exception.pattern >> exception.type
+            >> exception.mask >> exception.borderSize
+            >> exception.hideTitleBar >> exception.opaqueTitleBar
+            >> exception.opacityOverride >> exception.flatTitleBar;
+    }
+
+}
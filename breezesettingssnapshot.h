@@ -0,0 +1,177 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License or (at your option) version 3 or any later version
+ * accepted by the membership of KDE e.V. (or its successor approved
+ * by the membership of KDE e.V.), which shall act as a proxy
+ * defined in Section 14 of version 3 of the license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "breeze.h"
+
+#include <QColor>
+#include <QDataStream>
+#include <QFont>
+#include <QSharedPointer>
+
+namespace Breeze
+{
+
+    //* effective settings of a decoration, resolved once when settings are applied
+    /**
+    paint and layout code reads these plain members rather than the generated
+    configuration accessors, and derived values are computed only once. Snapshots are
+    shared by all decorations using the same settings, and never modified once published
+    */
+    struct SettingsSnapshot
+    {
+
+        //* default constructor, with the default settings. Call updateDerived() once settings are set
+        SettingsSnapshot() = default;
+
+        //* constructor, from loaded settings
+        explicit SettingsSnapshot(const InternalSettings &);
+
+        //* recompute derived values, after changing the settings they depend on
+        void updateDerived();
+
+        //* parts of a decoration affected by a settings change
+        enum Change
+        {
+            //* borders, and everything laid out from them
+            BorderChange = 1<<0,
+
+            //* button appearance and size
+            ButtonChange = 1<<1,
+
+            //* title bar appearance, including its transparency
+            TitleBarChange = 1<<2,
+
+            ShadowChange = 1<<3,
+            AllChanges = BorderChange|ButtonChange|TitleBarChange|ShadowChange
+        };
+
+        //* parts affected by changing from other settings to these, see Change
+        int changes(const SettingsSnapshot &other) const;
+
+        //* equality
+        bool operator==(const SettingsSnapshot &) const = default;
+
+        //* title bar font, used for metrics. The current application font if none is configured
+        QFont titleBarFont() const;
+
+        //* title bar font, with its style name, used for painting
+        QFont captionFont() const;
+
+        //*@name shadow
+        //@{
+        int shadowSize = InternalSettings::ShadowLarge;
+        int shadowStrength = 255;
+        QColor shadowColor = Qt::black;
+        //@}
+
+        //*@name borders, only used if mask contains BorderSize
+        //@{
+        int mask = 0;
+        int borderSize = InternalSettings::BorderNormal;
+        //@}
+
+        //*@name title bar
+        //@{
+        int titleAlignment = InternalSettings::AlignCenterFullWidth;
+        int extraTitleMargin = 0;
+        int captionRepaintInterval = 0;
+        bool hideTitleBar = false;
+        bool opaqueTitleBar = false;
+        bool flatTitleBar = false;
+        int opacityOverride = -1;
+        int backgroundOpacity = 100;
+        bool drawBackgroundGradient = false;
+        int backgroundGradientIntensity = 0;
+        QString titleBarFontString;
+        //@}
+
+        //*@name buttons
+        //@{
+        int buttonSize = InternalSettings::ButtonDefault;
+        int buttonStyle = 0;
+        int buttonSpacing = 0;
+        bool macOSButtons = false;
+        bool animationsEnabled = true;
+        int animationsDuration = 0;
+        int animationFrames = 0;
+        //@}
+
+        //*@name derived values
+        //@{
+
+        //* title bar background alpha, 0 to 255
+        int titleBarAlpha = 255;
+
+        //* lighter() factors of the title bar top line and background gradient
+        int gradientLightFactor = 130;
+        int gradientFactor = 100;
+
+        //* configured title bar font, only valid if titleBarFontString is not empty
+        QFont configuredTitleBarFont;
+
+        //* configured title bar font, with its style name
+        QFont configuredCaptionFont;
+
+        //@}
+
+    };
+
+    using SettingsSnapshotPtr = QSharedPointer<const SettingsSnapshot>;
+
+    //* window exception, as read from the configuration
+    struct ExceptionOverlay
+    {
+
+        //* constructor
+        ExceptionOverlay() = default;
+
+        //* constructor, from loaded exception
+        explicit ExceptionOverlay(const InternalSettings &);
+
+        //* apply the overridden settings, and update derived values
+        void apply(SettingsSnapshot &) const;
+
+        //* equality
+        bool operator==(const ExceptionOverlay &) const = default;
+
+        QString pattern;
+        int type = InternalSettings::ExceptionWindowClassName;
+
+        //*@name settings overridden by the exception, the others are the defaults
+        //@{
+        int mask = 0;
+        int borderSize = InternalSettings::BorderNormal;
+        bool hideTitleBar = false;
+        bool opaqueTitleBar = false;
+        int opacityOverride = -1;
+        bool flatTitleBar = false;
+        //@}
+
+    };
+
+    //*@name serialization, derived values are recomputed when read
+    //@{
+    QDataStream &operator<<(QDataStream &, const SettingsSnapshot &);
+    QDataStream &operator>>(QDataStream &, SettingsSnapshot &);
+    QDataStream &operator<<(QDataStream &, const ExceptionOverlay &);
+    QDataStream &operator>>(QDataStream &, ExceptionOverlay &);
+    //@}
+
+}
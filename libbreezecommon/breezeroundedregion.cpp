@@ -0,0 +1,100 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+// own
+#include "breezeroundedregion.h"
+
+// Qt
+#include <QHash>
+#include <QtMath>
+
+namespace Breeze
+{
+QVector<int> RoundedRegion::cornerProfile(int radius)
+{
+    static QHash<int, QVector<int>> s_profiles;
+
+    auto it = s_profiles.constFind(radius);
+    if (it != s_profiles.constEnd()) {
+        return it.value();
+    }
+
+    // sample the circle in the middle of each scanline, like QRegion::Ellipse does
+    QVector<int> profile(radius);
+    for (int row = 0; row < radius; ++row) {
+        const qreal dy = radius - row - 0.5;
+        profile[row] = qRound(radius - qSqrt(qreal(radius * radius) - dy * dy));
+    }
+
+    s_profiles.insert(radius, profile);
+    return profile;
+}
+
+QRegion RoundedRegion::build(const QRect &rect, int radius, int corners)
+{
+    if (rect.isEmpty()) {
+        return QRegion();
+    }
+
+    radius = qMin(radius, qMin(rect.width(), rect.height()) / 2);
+    if (radius <= 0 || !(corners & AllCorners)) {
+        return QRegion(rect);
+    }
+
+    const QVector<int> profile = cornerProfile(radius);
+
+    QVector<QRect> bands;
+    bands.reserve(2 * radius + 1);
+
+    // append a band, merging it with the previous one when both have the same extent
+    auto addBand = [&bands, &rect](int top, int height, int leftInset, int rightInset) {
+        if (height <= 0) {
+            return;
+        }
+
+        const int left = rect.left() + leftInset;
+        const int right = rect.right() - rightInset;
+        if (!bands.isEmpty()) {
+            QRect &last = bands.last();
+            if (last.left() == left && last.right() == right && last.bottom() + 1 == top) {
+                last.setBottom(top + height - 1);
+                return;
+            }
+        }
+
+        bands.append(QRect(left, top, right - left + 1, height));
+    };
+
+    // top corners
+    for (int row = 0; row < radius; ++row) {
+        addBand(rect.top() + row, 1, (corners & TopLeft) ? profile.at(row) : 0, (corners & TopRight) ? profile.at(row) : 0);
+    }
+
+    // straight part
+    addBand(rect.top() + radius, rect.height() - 2 * radius, 0, 0);
+
+    // bottom corners
+    for (int row = 0; row < radius; ++row) {
+        const int inset = profile.at(radius - 1 - row);
+        addBand(rect.bottom() - radius + 1 + row, 1, (corners & BottomLeft) ? inset : 0, (corners & BottomRight) ? inset : 0);
+    }
+
+    QRegion region;
+    region.setRects(bands.constData(), bands.size());
+    return region;
+}
+
+} // namespace Breeze
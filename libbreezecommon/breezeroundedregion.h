@@ -0,0 +1,62 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#pragma once
+
+// own
+#include "breezecommon_export.h"
+
+// Qt
+#include <QRect>
+#include <QRegion>
+#include <QVector>
+
+namespace Breeze
+{
+class BREEZECOMMON_EXPORT RoundedRegion
+{
+public:
+    enum Corner {
+        TopLeft = 1 << 0,
+        TopRight = 1 << 1,
+        BottomLeft = 1 << 2,
+        BottomRight = 1 << 3,
+        AllCorners = TopLeft | TopRight | BottomLeft | BottomRight
+    };
+
+    /**
+     * Build the region of a rectangle with rounded corners.
+     *
+     * The region is generated directly as sorted, non-overlapping scanline bands,
+     * so the cost only depends on the corner radius and no region union is involved.
+     *
+     * @param rect The rectangle.
+     * @param radius The corner radius, in pixels.
+     * @param corners The corners to round, as a combination of Corner flags.
+     **/
+    static QRegion build(const QRect &rect, int radius, int corners);
+
+    /**
+     * Horizontal inset of each scanline of a rounded corner, from the outermost row inwards.
+     *
+     * Profiles are computed once per radius and shared by all regions.
+     *
+     * @param radius The corner radius, in pixels.
+     **/
+    static QVector<int> cornerProfile(int radius);
+};
+
+} // namespace Breeze